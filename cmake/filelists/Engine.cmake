@@ -9,10 +9,16 @@ src/C4AudioSystem.h
 src/C4AudioSystemNone.h
 src/C4Aul.cpp
 src/C4Aul.h
+src/C4AulCodeCache.cpp
+src/C4AulCodeCache.h
 src/C4AulExec.cpp
 src/C4AulLink.cpp
 src/C4AulParse.cpp
 src/C4AulScriptStrict.h
+src/C4AulSnippetCache.cpp
+src/C4AulSnippetCache.h
+src/C4AulStackProfiler.cpp
+src/C4AulStackProfiler.h
 src/C4Awaiter.cpp
 src/C4Awaiter.h
 src/C4ChatDlg.cpp
@@ -260,6 +266,8 @@ src/C4Scoreboard.cpp
 src/C4Scoreboard.h
 src/C4Script.cpp
 src/C4Script.h
+src/C4ScriptBenchmark.cpp
+src/C4ScriptBenchmark.h
 src/C4ScriptHost.cpp
 src/C4ScriptHost.h
 src/C4Sector.cpp
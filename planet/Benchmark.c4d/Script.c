@@ -0,0 +1,177 @@
+/* Script benchmarks, run by the scriptbench target */
+/* Every function named Bench* is one benchmark; it is called once to warm up and then once per iteration. */
+
+#strict 3
+
+/* Calls and arithmetic */
+
+func BenchCall()
+{
+	var sum = 0;
+	for (var i = 0; i < 1000; ++i)
+		sum = Add(sum, i);
+	return sum;
+}
+
+func Add(int a, int b)
+{
+	return a + b;
+}
+
+func BenchArithmetic()
+{
+	var x = 1;
+	for (var i = 0; i < 1000; ++i)
+		x = (x * 31 + i) % 65521;
+	return x;
+}
+
+/* Arrays */
+
+func BenchArray()
+{
+	var a = [];
+	for (var i = 0; i < 1000; ++i)
+		a[i] = i;
+	var sum = 0;
+	for (var x in a)
+		sum += x;
+	return sum;
+}
+
+func BenchCoordinatePairs()
+{
+	var sum = 0;
+	for (var i = 0; i < 1000; ++i)
+	{
+		var pos = [i, -i];
+		sum += pos[0] + pos[1];
+	}
+	return sum;
+}
+
+func BenchSmallArrays()
+{
+	// short FindObjects-style results, copied and changed
+	var sum = 0;
+	for (var i = 0; i < 1000; ++i)
+	{
+		var found = [i, i + 1, i + 2];
+		var sorted = found;
+		sorted[0] = found[2];
+		sum += GetLength(sorted) + sorted[0];
+	}
+	return sum;
+}
+
+/* Maps */
+
+func BenchMapInsert()
+{
+	var m = {};
+	for (var i = 0; i < 1000; ++i)
+		m[i] = i;
+	return GetLength(m);
+}
+
+func BenchMapLookup()
+{
+	var m = CreateBenchMap(1000);
+	var sum = 0;
+	for (var i = 0; i < 1000; ++i)
+		sum += m[i];
+	return sum;
+}
+
+func BenchMapIterate()
+{
+	var m = CreateBenchMap(1000);
+	var sum = 0;
+	for (var key, value in m)
+		sum += key + value;
+	return sum;
+}
+
+func BenchMapForeachBreak()
+{
+	// loops left early must not slow down later inserts
+	var m = CreateBenchMap(100);
+	for (var i = 0; i < 100; ++i)
+	{
+		for (var key, value in m)
+			if (key == i) break;
+		m[1000 + i] = i;
+	}
+	return GetLength(m);
+}
+
+func CreateBenchMap(int size)
+{
+	var m = {};
+	for (var i = 0; i < size; ++i)
+		m[i] = i;
+	return m;
+}
+
+/* Strings */
+
+static const BENCH_Separator = "|";
+
+func BenchConcatAppend()
+{
+	var msg = "";
+	for (var i = 0; i < 200; ++i)
+		msg ..= "Line " .. i .. "|";
+	return GetLength(msg);
+}
+
+func BenchConcatChain()
+{
+	var msg = "";
+	for (var i = 0; i < 200; ++i)
+		msg = msg .. "Player " .. i .. ": " .. i * 10 .. " points|";
+	return GetLength(msg);
+}
+
+func BenchConstConcat()
+{
+	// string constants are stored in the byte code like literals
+	var msg = "";
+	for (var i = 0; i < 200; ++i)
+		msg ..= i .. BENCH_Separator;
+	return GetLength(msg);
+}
+
+func BenchFormatAppend()
+{
+	var msg = "";
+	for (var i = 0; i < 200; ++i)
+		msg = Format("%s%d: %d|", msg, i, i * 10);
+	return GetLength(msg);
+}
+
+/* Effects */
+
+func BenchEffectTimers()
+{
+	// the runner executes the global effects after every call, so each call is one frame:
+	// many effects with long intervals and a few which are due every frame
+	if (!GetEffectCount("BenchIdle"))
+	{
+		for (var i = 0; i < 1000; ++i)
+			AddEffect("BenchIdle", nil, 1, 100 + i, nil, BNCH);
+		for (var j = 0; j < 10; ++j)
+			AddEffect("BenchBusy", nil, 1, 1, nil, BNCH);
+	}
+	return true;
+}
+
+func FxBenchIdleTimer(object target, int number, int time)
+{
+	return 0;
+}
+
+func FxBenchBusyTimer(object target, int number, int time)
+{
+	return 0;
+}
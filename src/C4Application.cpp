@@ -30,6 +30,7 @@
 #include <C4Console.h>
 #include <C4Startup.h>
 #include <C4Log.h>
+#include <C4ScriptBenchmark.h>
 #include <C4GamePadCon.h>
 #include <C4GameLobby.h>
 #include "C4Toast.h"
@@ -80,6 +81,8 @@ void C4Application::DoInit()
 	// Config overwrite by parameter
 	StdStrBuf sConfigFilename;
 	bool verbose{false};
+	std::optional<std::string> scriptBenchmark;
+	std::int32_t scriptBenchmarkIterations{C4ScriptBenchmark::DefaultIterations};
 	char szParameter[_MAX_PATH + 1];
 	for (int32_t iPar = 0; SGetParameter(GetCommandLine(), iPar, szParameter, _MAX_PATH); iPar++)
 	{
@@ -91,6 +94,18 @@ void C4Application::DoInit()
 		{
 			verbose = true;
 		}
+		else if (SEqualNoCase(szParameter, "/scriptbench"))
+		{
+			scriptBenchmark = C4ScriptBenchmark::DefaultMask;
+		}
+		else if (SEqual2NoCase(szParameter, "/scriptbench:"))
+		{
+			scriptBenchmark = szParameter + 13;
+		}
+		else if (SEqual2NoCase(szParameter, "/benchiterations:"))
+		{
+			scriptBenchmarkIterations = strtol(szParameter + 17, nullptr, 10);
+		}
 	}
 	// Config check
 	Config.Init();
@@ -161,6 +176,17 @@ void C4Application::DoInit()
 	// Initialize curl
 	CurlSystem.emplace();
 
+	// Headless script benchmarks: no window, graphics or game needed
+	if (scriptBenchmark)
+	{
+		if (!C4ScriptBenchmark{*std::move(scriptBenchmark), scriptBenchmarkIterations}.Run())
+		{
+			throw StartupException{"Script benchmark failed!"};
+		}
+		Quit();
+		return;
+	}
+
 #ifdef _WIN32
 	// Windows: handle incoming updates directly, even before starting up the gui
 	//          because updates will be applied in the console anyway.
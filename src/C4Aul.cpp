@@ -430,6 +430,16 @@ void C4AulScriptFunc::CopyBody(C4AulScriptFunc &FromFunc)
 	NextSNFunc = nullptr;
 }
 
+void C4AulScriptFunc::ResolveOverloaded()
+{
+	// *MUST* check Owner-list, because it may be the engine (due to linked globals)
+	if (OwnerOverloaded = Owner->GetOverloadedFunc(this))
+		if (Owner == OwnerOverloaded->Owner)
+			OwnerOverloaded->OverloadedBy = this;
+	// reset pointer to next same-named func (will be set in AfterLink)
+	NextSNFunc = nullptr;
+}
+
 // C4AulScriptEngine
 
 C4AulScriptEngine::C4AulScriptEngine() :
@@ -454,6 +464,8 @@ C4AulScriptEngine::~C4AulScriptEngine() { Clear(); }
 
 void C4AulScriptEngine::Clear()
 {
+	// cached snippets are children of other scripts
+	Snippets.Clear();
 	// clear inherited
 	C4AulScript::Clear();
 	// clear own stuff
@@ -472,6 +484,8 @@ void C4AulScriptEngine::Clear()
 
 void C4AulScriptEngine::UnLink()
 {
+	// cached snippets reference linked funcs and held strings
+	Snippets.Clear();
 	// unlink scripts
 	C4AulScript::UnLink();
 	// clear string table ("hold" strings only)
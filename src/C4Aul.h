@@ -24,6 +24,7 @@
 #pragma once
 
 #include <C4AulScriptStrict.h>
+#include <C4AulSnippetCache.h>
 #include <C4ValueList.h>
 #include <C4ValueMap.h>
 #include <C4Id.h>
@@ -32,7 +33,9 @@
 #include <C4StringTable.h>
 
 #include <cstdint>
+#include <initializer_list>
 #include <list>
+#include <span>
 #include <vector>
 
 // class predefs
@@ -115,6 +118,8 @@ struct C4AulParSet
 
 	C4Value &operator[](int iIdx) { return Par[iIdx]; }
 	const C4Value &operator[](int iIdx) const { return Par[iIdx]; }
+
+	operator std::span<const C4Value>() const noexcept { return Par; }
 };
 
 #define Copy2ParSet8(Pars, Vars) Pars[0].Set(Vars##0); Pars[1].Set(Vars##1); Pars[2].Set(Vars##2); Pars[3].Set(Vars##3); Pars[4].Set(Vars##4); Pars[5].Set(Vars##5); Pars[6].Set(Vars##6); Pars[7].Set(Vars##7);
@@ -281,6 +286,7 @@ class C4AulFunc
 	friend class C4AulScriptEngine;
 	friend class C4AulFuncMap;
 	friend class C4AulParseState;
+	friend class C4AulCodeCache;
 
 public:
 	C4AulFunc(C4AulScript *pOwner, const char *pName, bool bAtEnd = true);
@@ -306,7 +312,14 @@ public:
 	virtual const C4V_Type *GetParType() { return nullptr; }
 	virtual C4V_Type GetRetType() { return C4V_Any; }
 	virtual C4Value Exec(C4AulContext *pCallerCtx, const C4Value pPars[], bool fPassErrors = false) { return C4Value(); } // execute func (script call)
-	virtual C4Value Exec(C4Object *pObj = nullptr, const C4AulParSet &pPars = C4AulParSet{}, bool fPassErrors = false, bool nonStrict3WarnConversionOnly = false, bool convertNilToIntBool = true); // execute func (engine call)
+	virtual C4Value Exec(C4Object *pObj = nullptr, std::span<const C4Value> pars = {}, bool fPassErrors = false, bool nonStrict3WarnConversionOnly = false, bool convertNilToIntBool = true); // execute func (engine call); missing parameters are nil
+
+	// engine call with parameters listed in place, e.g. Exec(pObj, {C4VInt(iX), C4VInt(iY)}), without building a C4AulParSet
+	C4Value Exec(C4Object *pObj, std::initializer_list<C4Value> pars, bool fPassErrors = false, bool nonStrict3WarnConversionOnly = false, bool convertNilToIntBool = true)
+	{
+		return Exec(pObj, std::span{pars.begin(), pars.size()}, fPassErrors, nonStrict3WarnConversionOnly, convertNilToIntBool);
+	}
+
 	virtual void UnLink() { OverloadedBy = NextSNFunc = nullptr; }
 
 	C4AulFunc *GetLocalSFunc(const char *szIdtf); // find script function in own scope
@@ -358,9 +371,11 @@ public:
 	virtual const C4V_Type *GetParType() override { return ParType; }
 	virtual C4V_Type GetRetType() override { return bReturnRef ? C4V_pC4Value : C4V_Any; }
 	virtual C4Value Exec(C4AulContext *pCallerCtx, const C4Value pPars[], bool fPassErrors = false) override; // execute func (script call, should not happen)
-	virtual C4Value Exec(C4Object *pObj = nullptr, const C4AulParSet &pPars = C4AulParSet{}, bool fPassErrors = false, bool nonStrict3WarnConversionOnly = false, bool convertNilToIntBool = true) override; // execute func (engine call)
+	virtual C4Value Exec(C4Object *pObj = nullptr, std::span<const C4Value> pars = {}, bool fPassErrors = false, bool nonStrict3WarnConversionOnly = false, bool convertNilToIntBool = true) override; // execute func (engine call)
+	using C4AulFunc::Exec;
 
 	void CopyBody(C4AulScriptFunc &FromFunc); // copy script/code, etc from given func
+	void ResolveOverloaded(); // find the func overloaded by this one; all func tables must be built
 
 	std::string GetFullName(); // get a fully classified name (C4ID::Name) for debug output
 
@@ -484,7 +499,12 @@ protected:
 	bool Preparse(); // preparse script; return if successful
 	void ParseFn(C4AulScriptFunc *Fn, bool fExprOnly = false); // parse single script function
 
-	bool Parse(); // parse preparsed script; return if successful
+	bool Parse(); // parse preparsed script and children; return if successful
+	void CollectParseScripts(std::vector<C4AulScript *> &scripts); // get scripts that need parsing, children first
+	C4AulScriptFunc *GetParsedFunc(C4AulFunc *f); // get the script func whose code is generated into this script for func list entry f
+	void ParseFuncs(); // generate byte code for all funcs; may run on a worker thread
+	void ResolveStrings(const std::vector<C4String *> &strings); // replace the string indices written by ParseFuncs
+	void FinishParse(); // calc code addresses after ParseFuncs
 	void ParseDescs(); // parse function descs
 
 	bool ResolveIncludes(C4DefList *rDefs); // resolve includes
@@ -533,6 +553,7 @@ public:
 	friend class C4AulScriptFunc;
 	friend class C4AulScriptEngine;
 	friend class C4AulParseState;
+	friend class C4AulCodeCache;
 };
 
 // holds all C4AulScripts
@@ -552,6 +573,8 @@ public:
 
 	C4StringTable Strings;
 
+	C4AulSnippetCache Snippets; // compiled DirectExec code
+
 	// global constants (such as "static const C4D_Structure = 2;")
 	// cannot share var lists, because it's so closely tied to the data lists
 	// constants are used by the Parser only, anyway, so it's not
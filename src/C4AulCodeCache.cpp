@@ -0,0 +1,384 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// persistent cache for the byte code generated by C4AulScript::Parse
+
+#include <C4Include.h>
+#include <C4AulCodeCache.h>
+
+#include <C4Components.h>
+#include <C4Config.h>
+#include <C4Log.h>
+#include <C4Version.h>
+#include "StdAdaptors.h"
+#include "StdFile.h"
+#include "StdSha1.h"
+
+#include <algorithm>
+#include <format>
+#include <ranges>
+#include <span>
+#include <unordered_map>
+#include <utility>
+
+namespace
+{
+	bool IsFuncRef(const C4AulBCCType type)
+	{
+		switch (type)
+		{
+		case AB_FUNC: case AB_CALL: case AB_CALLFS: case AB_CALLGLOBAL:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	bool IsStringRef(const C4AulBCCType type)
+	{
+		switch (type)
+		{
+		case AB_STRING: case AB_MAPA_R: case AB_MAPA_V:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	// bccX is a jump distance
+	bool IsJump(const C4AulBCCType type)
+	{
+		switch (type)
+		{
+		case AB_JUMP: case AB_JUMPAND: case AB_JUMPOR: case AB_JUMPNIL: case AB_JUMPNOTNIL: case AB_CONDN: case AB_NilCoalescingIt:
+			return true;
+		default:
+			return false;
+		}
+	}
+}
+
+void C4AulCodeCache::Chunk::CompileFunc(StdCompiler *pComp)
+{
+	pComp->Value(Type);
+	pComp->Value(X);
+	pComp->Value(FuncScript);
+	pComp->Value(SPosScript);
+	pComp->Value(SPos);
+	pComp->Value(String);
+}
+
+void C4AulCodeCache::ScriptCode::CompileFunc(StdCompiler *pComp)
+{
+	pComp->Value(Parsed);
+	pComp->Value(mkSTLContainerAdapt(Code));
+	pComp->Value(mkSTLContainerAdapt(FuncOffsets));
+}
+
+void C4AulCodeCache::CacheFile::CompileFunc(StdCompiler *pComp)
+{
+	pComp->Value(Version);
+	pComp->Value(Key);
+	pComp->Value(mkSTLContainerAdapt(Scripts));
+}
+
+C4AulCodeCache::C4AulCodeCache(C4AulScriptEngine &engine) : engine{engine}
+{
+	if (!Config.Developer.ScriptBytecodeCache) return;
+	CollectScripts(&engine);
+	CalcKey();
+}
+
+void C4AulCodeCache::CollectScripts(C4AulScript *const script)
+{
+	// DirectExec scripts aren't part of the linked tree
+	if (script->Temporary) return;
+	// same order as C4AulScript::Parse: children first
+	for (C4AulScript *child = script->Child0; child; child = child->Next)
+		CollectScripts(child);
+	scripts.push_back(script);
+	needsParse.push_back(script != &engine && script->State == ASS_LINKED);
+}
+
+void C4AulCodeCache::CalcKey()
+{
+	StdSha1 sha1;
+	const auto update = [&sha1](const std::string_view data)
+	{
+		sha1.Update(data.data(), data.size());
+		sha1.Update("", 1);
+	};
+	const auto updateNames = [&update](const C4ValueMapNames &names)
+	{
+		for (std::int32_t i = 0; i < names.iSize; ++i)
+			update(names.pNames[i]);
+	};
+
+	update(C4VERSION);
+	update(std::to_string(FormatVersion));
+
+	// the func lists are hashed as well, because functions are referenced by their list position
+	for (C4AulScript *const script : scripts)
+	{
+		update(script->ScriptName);
+		update(std::to_string(script->State));
+		update(script->Script.getData() ? script->Script.getData() : "");
+		updateNames(script->LocalNamed);
+		for (C4AulFunc *f = script->Func0; f; f = f->Next)
+		{
+			update(f->Name);
+			update(f->SFunc() ? "s" : "e");
+		}
+	}
+
+	updateNames(engine.GlobalNamedNames);
+	updateNames(engine.GlobalConstNames);
+	for (std::int32_t i = 0; i < engine.GlobalConstNames.iSize; ++i)
+		update(engine.GlobalConsts.GetItem(i)->GetDataString());
+
+	std::uint8_t hash[StdSha1::DigestLength];
+	sha1.GetHash(hash);
+	for (const auto byte : hash)
+		key += std::format("{:02x}", byte);
+}
+
+std::string C4AulCodeCache::GetCacheFilename() const
+{
+	return std::format("{}{}{}.c4b", Config.AtUserPath(C4CFN_ScriptCache), DirSep, key);
+}
+
+bool C4AulCodeCache::Restore()
+{
+	if (key.empty()) return false;
+
+	StdBuf buf;
+	if (!buf.LoadFromFile(GetCacheFilename().c_str())) return false;
+
+	CacheFile file;
+	try
+	{
+		CompileFromBuf<StdCompilerBinRead>(file, buf);
+	}
+	catch (const StdCompiler::Exception &)
+	{
+		return false;
+	}
+	if (file.Version != FormatVersion || file.Key != key || file.Scripts.size() != scripts.size()) return false;
+
+	std::vector<std::vector<C4AulFunc *>> funcs;
+	funcs.reserve(scripts.size());
+	for (C4AulScript *const script : scripts)
+	{
+		auto &list = funcs.emplace_back();
+		for (C4AulFunc *f = script->Func0; f; f = f->Next)
+			list.push_back(f);
+	}
+
+	// relocate everything first, so a damaged cache file leaves the scripts untouched
+	std::vector<std::vector<C4AulBCC>> code(scripts.size());
+	for (std::size_t i = 0; i < scripts.size(); ++i)
+	{
+		const ScriptCode &scriptCode{file.Scripts[i]};
+		if (scriptCode.Parsed != needsParse[i]) return false;
+		if (!scriptCode.Parsed) continue;
+
+		for (const Chunk &chunk : scriptCode.Code)
+		{
+			// the executor trusts types, pointers and jump distances, so nothing unknown may get through
+			if (chunk.Type < AB_DEREF || chunk.Type > AB_EOF) return false;
+
+			C4AulBCC &bcc{code[i].emplace_back()};
+			bcc.bccType = static_cast<C4AulBCCType>(chunk.Type);
+			bcc.bccX = static_cast<std::intptr_t>(chunk.X);
+			bcc.SPos = nullptr;
+
+			if (chunk.SPosScript >= 0)
+			{
+				if (static_cast<std::size_t>(chunk.SPosScript) >= scripts.size()) return false;
+				const StdStrBuf &source{scripts[chunk.SPosScript]->Script};
+				if (chunk.SPos < 0 || static_cast<std::size_t>(chunk.SPos) > source.getLength()) return false;
+				bcc.SPos = source.getPtr(chunk.SPos);
+			}
+
+			if (IsFuncRef(bcc.bccType))
+			{
+				// a function pointer is either restored from its index or null
+				if (chunk.FuncScript < 0)
+				{
+					if (chunk.X) return false;
+				}
+				else
+				{
+					if (static_cast<std::size_t>(chunk.FuncScript) >= funcs.size()) return false;
+					const auto &list = funcs[chunk.FuncScript];
+					if (chunk.X < 0 || static_cast<std::size_t>(chunk.X) >= list.size()) return false;
+					bcc.bccX = reinterpret_cast<std::intptr_t>(list[chunk.X]);
+				}
+			}
+			else if (chunk.FuncScript >= 0)
+			{
+				return false;
+			}
+			else if (IsStringRef(bcc.bccType) && chunk.X)
+			{
+				// held like the strings registered by the parser
+				C4String *string;
+				if (!(string = engine.Strings.FindString(chunk.String.c_str())))
+					string = engine.Strings.RegString(chunk.String.c_str());
+				string->Hold = true;
+				bcc.bccX = reinterpret_cast<std::intptr_t>(string);
+			}
+		}
+
+		for (std::size_t pos = 0; pos < code[i].size(); ++pos)
+		{
+			const C4AulBCC &bcc{code[i][pos]};
+			if (!IsJump(bcc.bccType)) continue;
+			const auto target = static_cast<std::int64_t>(pos) + bcc.bccX;
+			if (target < 0 || target >= static_cast<std::int64_t>(code[i].size())) return false;
+		}
+
+		std::size_t funcCount{0};
+		for (C4AulFunc *f : funcs[i])
+			if (scripts[i]->GetParsedFunc(f)) ++funcCount;
+		if (code[i].empty() || scriptCode.FuncOffsets.size() != funcCount) return false;
+		for (const auto offset : scriptCode.FuncOffsets)
+			if (offset < 0 || static_cast<std::size_t>(offset) >= code[i].size()) return false;
+	}
+
+	// install the code
+	for (std::size_t i = 0; i < scripts.size(); ++i)
+	{
+		if (!needsParse[i]) continue;
+		C4AulScript *const script{scripts[i]};
+
+		delete[] script->Code;
+		script->CodeSize = script->CodeBufSize = static_cast<int>(code[i].size());
+		script->Code = new C4AulBCC[code[i].size()];
+		std::ranges::copy(code[i], script->Code);
+		script->CPos = script->Code + script->CodeSize;
+
+		auto offset = file.Scripts[i].FuncOffsets.begin();
+		for (C4AulFunc *f : funcs[i])
+		{
+			if (C4AulScriptFunc *const Fn{script->GetParsedFunc(f)})
+			{
+				Fn->ResolveOverloaded();
+				Fn->Code = script->Code + *offset++;
+			}
+		}
+
+		engine.lineCnt += SGetLine(script->Script.getData(), script->Script.getPtr(script->Script.getLength()));
+		script->State = ASS_PARSED;
+	}
+
+	LogNTr(spdlog::level::debug, "C4AulScriptEngine: byte code restored from cache {}", key);
+	return true;
+}
+
+void C4AulCodeCache::Store()
+{
+	if (key.empty()) return;
+
+	std::unordered_map<C4AulFunc *, std::pair<std::int32_t, std::int32_t>> funcIndices;
+	std::vector<std::pair<const char *, std::int32_t>> sources; // sorted by start address
+	for (std::size_t i = 0; i < scripts.size(); ++i)
+	{
+		std::int32_t index{0};
+		for (C4AulFunc *f = scripts[i]->Func0; f; f = f->Next)
+			funcIndices.emplace(f, std::make_pair(static_cast<std::int32_t>(i), index++));
+		if (scripts[i]->Script.getData())
+			sources.emplace_back(scripts[i]->Script.getData(), static_cast<std::int32_t>(i));
+	}
+	std::ranges::sort(sources);
+
+	const auto findSource = [&sources, this](const char *const pos) -> std::int32_t
+	{
+		auto it = std::ranges::upper_bound(sources, pos, {}, &std::pair<const char *, std::int32_t>::first);
+		if (it == sources.begin()) return -1;
+		--it;
+		const StdStrBuf &source{scripts[it->second]->Script};
+		return pos <= source.getPtr(source.getLength()) ? it->second : -1;
+	};
+
+	CacheFile file{FormatVersion, key, {}};
+	for (std::size_t i = 0; i < scripts.size(); ++i)
+	{
+		C4AulScript *const script{scripts[i]};
+		ScriptCode &scriptCode{file.Scripts.emplace_back()};
+		scriptCode.Parsed = needsParse[i];
+		if (!scriptCode.Parsed) continue;
+		// parsing failed completely?
+		if (script->State != ASS_PARSED) return;
+
+		for (const C4AulBCC &bcc : std::span{script->Code, static_cast<std::size_t>(script->CodeSize)})
+		{
+			Chunk chunk{static_cast<std::int32_t>(bcc.bccType), static_cast<std::int64_t>(bcc.bccX), -1, -1, 0, {}};
+			if (bcc.SPos)
+			{
+				chunk.SPosScript = findSource(bcc.SPos);
+				// not pointing into any script (e.g. into a temporary buffer): can't be cached
+				if (chunk.SPosScript < 0) return;
+				chunk.SPos = static_cast<std::int32_t>(bcc.SPos - scripts[chunk.SPosScript]->Script.getData());
+			}
+
+			if (IsFuncRef(bcc.bccType) && bcc.bccX)
+			{
+				const auto it = funcIndices.find(reinterpret_cast<C4AulFunc *>(bcc.bccX));
+				if (it == funcIndices.end()) return;
+				std::tie(chunk.FuncScript, chunk.X) = it->second;
+			}
+			else if (IsStringRef(bcc.bccType) && bcc.bccX)
+			{
+				chunk.X = 1;
+				chunk.String = reinterpret_cast<C4String *>(bcc.bccX)->Data.getData();
+			}
+
+			scriptCode.Code.push_back(std::move(chunk));
+		}
+
+		for (C4AulFunc *f = script->Func0; f; f = f->Next)
+			if (C4AulScriptFunc *const Fn{script->GetParsedFunc(f)})
+				scriptCode.FuncOffsets.push_back(static_cast<std::int32_t>(Fn->Code - script->Code));
+	}
+
+	const char *const path{Config.AtUserPath(C4CFN_ScriptCache)};
+	if (!DirectoryExists(path) && !MakeDirectory(path, nullptr)) return;
+
+	try
+	{
+		if (!DecompileToBuf<StdCompilerBinWrite>(file).SaveToFile(GetCacheFilename().c_str())) return;
+	}
+	catch (const StdCompiler::Exception &)
+	{
+		return;
+	}
+
+	RemoveOldFiles();
+}
+
+void C4AulCodeCache::RemoveOldFiles()
+{
+	std::vector<std::pair<time_t, std::string>> files;
+	for (DirectoryIterator it{Config.AtUserPath(C4CFN_ScriptCache)}; *it; ++it)
+		if (WildcardMatch("*.c4b", GetFilename(*it)))
+			files.emplace_back(FileTime(*it), *it);
+
+	if (files.size() <= MaxFiles) return;
+
+	std::ranges::sort(files, std::ranges::greater{});
+	for (const auto &[time, filename] : files | std::views::drop(MaxFiles))
+		EraseFile(filename.c_str());
+}
@@ -0,0 +1,82 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// persistent cache for the byte code generated by C4AulScript::Parse
+
+#pragma once
+
+#include "C4Aul.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class StdCompiler;
+
+// The byte code of a script depends on all other scripts (overloads, global funcs and constants, #include and #appendto),
+// so the whole linked script tree is hashed into a single key; any change to any script or to the engine invalidates the cache.
+// Function and string pointers and source positions in the byte code are stored as indices and relocated on restore.
+class C4AulCodeCache
+{
+public:
+	C4AulCodeCache(C4AulScriptEngine &engine); // must be constructed after includes and appends are resolved
+
+	bool Restore(); // restore byte code of all scripts that need parsing; returns false if the scripts have to be parsed
+	void Store(); // save byte code of all scripts parsed since construction
+
+private:
+	static constexpr std::uint32_t FormatVersion = 1;
+	static constexpr std::size_t MaxFiles = 8; // number of cache files kept; the oldest ones are removed
+
+	struct Chunk
+	{
+		std::int32_t Type;
+		std::int64_t X; // plain value, or function index within script FuncScript
+		std::int32_t FuncScript; // script index of referenced function; -1 if none
+		std::int32_t SPosScript; // script index of source position; -1 if none
+		std::int32_t SPos; // offset into source of script SPosScript
+		std::string String; // content of referenced string
+
+		void CompileFunc(StdCompiler *pComp);
+	};
+
+	struct ScriptCode
+	{
+		bool Parsed;
+		std::vector<Chunk> Code;
+		std::vector<std::int32_t> FuncOffsets; // code offsets of the parsed funcs, in func list order
+
+		void CompileFunc(StdCompiler *pComp);
+	};
+
+	struct CacheFile
+	{
+		std::uint32_t Version;
+		std::string Key;
+		std::vector<ScriptCode> Scripts;
+
+		void CompileFunc(StdCompiler *pComp);
+	};
+
+	C4AulScriptEngine &engine;
+	std::vector<C4AulScript *> scripts; // all scripts, in parse order
+	std::vector<bool> needsParse; // whether Parse() will generate code for the script
+	std::string key;
+
+	void CollectScripts(C4AulScript *script);
+	void CalcKey();
+	std::string GetCacheFilename() const;
+	void RemoveOldFiles();
+};
@@ -19,6 +19,7 @@
 
 #include <C4Include.h>
 #include <C4Aul.h>
+#include <C4AulStackProfiler.h>
 
 #include <C4Object.h>
 #include <C4Config.h>
@@ -26,7 +27,12 @@
 #include <C4ValueHash.h>
 #include <C4Wrappers.h>
 
+#include <algorithm>
 #include <format>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
 
 C4AulExecError::C4AulExecError(C4Object *pObj, const std::string_view error)
 	: cObj(pObj)
@@ -59,8 +65,13 @@ bool C4AulContext::CalledWithStrictNil() const noexcept
 	return Caller && Caller->Func->HasStrictNil();
 }
 
-const int MAX_CONTEXT_STACK = 512;
-const int MAX_VALUE_STACK = 1024;
+// hard limits of the script stacks; fixed, so recursion fails at the same depth on all clients
+const int MAX_CONTEXT_STACK = 4096;
+const int MAX_VALUE_STACK = 65536;
+
+// number of elements the stacks grow by at once
+const int CONTEXT_STACK_GROW_STEP = 64;
+const int VALUE_STACK_GROW_STEP = 1024;
 
 void C4AulScriptContext::dump(std::string Dump)
 {
@@ -107,40 +118,100 @@ void C4AulScriptContext::dump(std::string Dump)
 	DebugLog(Dump);
 }
 
+// Stack storage for C4AulExec. Memory for the hard limit is reserved up front so that
+// addresses stay stable (contexts and references point into the stacks), but elements
+// are only constructed once the stack actually grows into them.
+template<typename T>
+class C4AulExecStack
+{
+	T *storage{nullptr};
+	std::size_t limit{0};
+	std::size_t size{0};
+	std::size_t growStep;
+
+public:
+	C4AulExecStack(const std::size_t limit, const std::size_t growStep)
+		: storage{static_cast<T *>(::operator new(limit * sizeof(T)))}, limit{limit}, growStep{growStep} {}
+
+	~C4AulExecStack()
+	{
+		Release();
+	}
+
+	C4AulExecStack(const C4AulExecStack &) = delete;
+	C4AulExecStack &operator=(const C4AulExecStack &) = delete;
+
+	T *Begin() const { return storage; }
+	T *End() const { return storage + size; } // end of the elements constructed so far
+
+	// Constructs elements so that at least newSize of them are usable. Returns false if the limit would be exceeded.
+	bool Grow(const std::size_t newSize)
+	{
+		if (newSize > limit) return false;
+		if (newSize <= size) return true;
+
+		const auto target = std::min(limit, std::max(newSize, size + growStep));
+		std::uninitialized_value_construct(storage + size, storage + target);
+		size = target;
+		return true;
+	}
+
+private:
+	void Release()
+	{
+		if (!storage) return;
+
+		std::destroy(storage, storage + size);
+		::operator delete(storage);
+		storage = nullptr;
+		size = 0;
+	}
+};
+
 class C4AulExec
 {
 public:
 	C4AulExec()
-		: pCurCtx(Contexts - 1), pCurVal(Values - 1), iTraceStart(-1) {}
+		: Contexts{MAX_CONTEXT_STACK, CONTEXT_STACK_GROW_STEP}, Values{MAX_VALUE_STACK, VALUE_STACK_GROW_STEP},
+		pCurCtx(Contexts.Begin() - 1), pCurVal(Values.Begin() - 1), iTraceStart(-1) {}
 
 private:
-	C4AulScriptContext Contexts[MAX_CONTEXT_STACK];
-	C4Value Values[MAX_VALUE_STACK];
+	C4AulExecStack<C4AulScriptContext> Contexts;
+	C4AulExecStack<C4Value> Values;
 
 	C4AulScriptContext *pCurCtx;
 	C4Value *pCurVal;
 
+	// iterators of running map foreach loops with the value stack slot holding them, ordered by slot;
+	// loops left by break or return release theirs when the slot is reused or the context is popped
+	std::vector<std::pair<const C4Value *, std::unique_ptr<C4ValueHash::Iterator>>> MapIterators;
+
 	std::shared_ptr<spdlog::logger> traceLogger;
 	int iTraceStart;
 	bool fProfiling;
 	time_t tDirectExecStart, tDirectExecTotal; // profiler time for DirectExec
 	C4AulScript *pProfiledScript;
+	std::unique_ptr<C4AulStackProfiler> stackProfiler;
 
 public:
 	C4Value Exec(C4AulScriptFunc *pSFunc, C4Object *pObj, const C4Value pPars[], bool fPassErrors, bool fTemporaryScript = false);
+	// pushes the parameters straight onto the value stack and checks and converts them there
+	C4Value Exec(C4AulScriptFunc *pSFunc, C4Object *pObj, std::span<const C4Value> pars, bool fPassErrors, bool convertToAnyEagerly, bool convertNilToIntBool, bool onlyWarn);
 	C4Value Exec(C4AulBCC *pCPos, bool fPassErrors);
 
 	void StartTrace();
 	void StartProfiling(C4AulScript *pScript); // resets profling times and starts recording the times
 	void StopProfiling(); // stop the profiler and displays results
 	void AbortProfiling() { fProfiling = false; }
+	void StartStackProfiling(std::int32_t sampleInterval); // restarts the call stack profiler
+	std::unique_ptr<C4AulStackProfiler> StopStackProfiling() { return std::move(stackProfiler); }
 	inline void StartDirectExec() { if (fProfiling) tDirectExecStart = timeGetTime(); }
 	inline void StopDirectExec() { if (fProfiling) tDirectExecTotal += timeGetTime() - tDirectExecStart; }
 
 private:
 	void PushContext(const C4AulScriptContext &rContext)
 	{
-		if (pCurCtx >= Contexts + MAX_CONTEXT_STACK - 1)
+		if (pCurCtx + 1 >= Contexts.End() && !Contexts.Grow(ContextStackSize() + 1))
 			throw C4AulExecError(pCurCtx->Obj, "context stack overflow!");
 		*++pCurCtx = rContext;
 		// Trace?
@@ -152,11 +223,12 @@ private:
 		}
 		// Profiler: Safe time to measure difference afterwards
 		if (fProfiling) pCurCtx->tTime = timeGetTime();
+		if (stackProfiler) stackProfiler->Enter(*pCurCtx);
 	}
 
 	void PopContext()
 	{
-		if (pCurCtx < Contexts)
+		if (pCurCtx < Contexts.Begin())
 			throw C4AulExecError(pCurCtx->Obj, "context stack underflow!");
 		// Profiler adding up times
 		if (fProfiling)
@@ -165,6 +237,7 @@ private:
 			if (dt && pCurCtx->Func)
 				pCurCtx->Func->tProfileTime += dt;
 		}
+		if (stackProfiler) stackProfiler->Leave();
 		// Trace done?
 		if (iTraceStart >= 0)
 		{
@@ -174,14 +247,21 @@ private:
 				traceLogger.reset();
 			}
 		}
+		ReleaseMapIterators(pCurCtx->Vars);
 		if (pCurCtx->TemporaryScript)
 			delete pCurCtx->Func->Owner;
 		pCurCtx--;
 	}
 
+	void ReleaseMapIterators(const C4Value *pFromVal)
+	{
+		while (!MapIterators.empty() && MapIterators.back().first >= pFromVal)
+			MapIterators.pop_back();
+	}
+
 	void CheckOverflow(intptr_t iCnt)
 	{
-		if (ValueStackSize() + iCnt > MAX_VALUE_STACK)
+		if (pCurVal + iCnt >= Values.End() && !Values.Grow(ValueStackSize() + iCnt))
 			throw C4AulExecError(pCurCtx->Obj, "internal error: value stack overflow!");
 	}
 
@@ -239,7 +319,7 @@ private:
 
 	void PopValuesUntil(C4Value *pUntilVal)
 	{
-		if (pUntilVal < Values - 1)
+		if (pUntilVal < Values.Begin() - 1)
 			throw C4AulExecError(pCurCtx->Obj, "internal error: value stack underflow!");
 		while (pCurVal > pUntilVal)
 			(pCurVal--)->Set0();
@@ -247,19 +327,19 @@ private:
 
 	int ContextStackSize() const
 	{
-		return pCurCtx - Contexts + 1;
+		return pCurCtx - Contexts.Begin() + 1;
 	}
 
 	int ValueStackSize() const
 	{
-		return pCurVal - Values + 1;
+		return pCurVal - Values.Begin() + 1;
 	}
 
 	int LocalValueStackSize() const
 	{
 		return ContextStackSize()
 			? pCurVal - pCurCtx->Vars - pCurCtx->Func->VarNamed.iSize + 1
-			: pCurVal - Values + 1;
+			: pCurVal - Values.Begin() + 1;
 	}
 
 	template<bool asReference = false, bool allowAny = true>
@@ -322,7 +402,25 @@ private:
 			CheckOpPar<false>(pCurVal, C4ScriptOpMap[iOpID].Type1, C4ScriptOpMap[iOpID].Identifier);
 	}
 
+	// Cheap tag checks for the common case of int operands, which need neither type checks nor conversion
+	// by the operators taking ints or any values; CheckOpPar(s) only has to be called if they fail.
+	template<bool asReference = false>
+	static bool IsIntOpPar(C4Value &value)
+	{
+		if constexpr (asReference)
+			return value.IsRef() && value.GetType() == C4V_Int;
+		else
+			return value._getType() == C4V_Int;
+	}
+
+	template<bool leftAsReference = false>
+	bool IntOpPars() { return IsIntOpPar<leftAsReference>(pCurVal[-1]) && IsIntOpPar(*pCurVal); }
+
+	template<bool asReference = false>
+	bool IntOpPar() { return IsIntOpPar<asReference>(*pCurVal); }
+
 	C4AulBCC *Call(C4AulFunc *pFunc, C4Value *pReturn, C4Value *pPars, C4Object *pObj = nullptr, C4Def *pDef = nullptr, bool globalContext = false);
+	C4Value ExecPushed(C4AulScriptFunc *pSFunc, C4Object *pObj, C4Value *pPars, bool fPassErrors, bool fTemporaryScript); // parameters are on the value stack from pPars
 };
 
 C4AulExec AulExec;
@@ -335,6 +433,11 @@ C4Value C4AulExec::Exec(C4AulScriptFunc *pSFunc, C4Object *pObj, const C4Value *
 		for (int i = 0; i < C4AUL_MAX_Par; i++)
 			PushValue(pnPars[i]);
 
+	return ExecPushed(pSFunc, pObj, pPars, fPassErrors, fTemporaryScript);
+}
+
+C4Value C4AulExec::ExecPushed(C4AulScriptFunc *pSFunc, C4Object *pObj, C4Value *pPars, bool fPassErrors, bool fTemporaryScript)
+{
 	// Push variables
 	C4Value *pVars = pCurVal + 1;
 	PushNullVals(pSFunc->VarNamed.iSize);
@@ -434,10 +537,11 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 						pCurCtx->dump(" by: ");
 					}
 				}
+				// the slot has been resolved by the parser and is within the object's local list (checked above after ChangeDef)
 				if (pCPos->bccType == AB_LOCALN_R)
-					PushValueRef(*pCurCtx->Obj->LocalNamed.GetItem(pCPos->bccX));
+					PushValueRef(pCurCtx->Obj->LocalNamed.pData[pCPos->bccX]);
 				else
-					PushValue(*pCurCtx->Obj->LocalNamed.GetItem(pCPos->bccX));
+					PushValue(pCurCtx->Obj->LocalNamed.pData[pCPos->bccX]);
 				break;
 
 			case AB_GLOBALN_R:
@@ -448,17 +552,17 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				break;
 			// prefix
 			case AB_Inc1: // ++
-				CheckOpPar<C4V_Int, false>(pCPos->bccX);
+				if (!IntOpPar<true>()) CheckOpPar<C4V_Int, false>(pCPos->bccX);
 				++pCurVal->GetData().Int;
 				pCurVal->HintType(C4V_Int);
 				break;
 			case AB_Dec1: // --
-				CheckOpPar<C4V_Int, false>(pCPos->bccX);
+				if (!IntOpPar<true>()) CheckOpPar<C4V_Int, false>(pCPos->bccX);
 				--pCurVal->GetData().Int;
 				pCurVal->HintType(C4V_Int);
 				break;
 			case AB_BitNot: // ~
-				CheckOpPar<C4V_Any, false>(pCPos->bccX);
+				if (!IntOpPar()) CheckOpPar<C4V_Any, false>(pCPos->bccX);
 				pCurVal->SetInt(~pCurVal->_getInt());
 				break;
 			case AB_Not: // !
@@ -466,13 +570,13 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				pCurVal->SetBool(!pCurVal->_getRaw());
 				break;
 			case AB_Neg: // -
-				CheckOpPar<C4V_Any, false>(pCPos->bccX);
+				if (!IntOpPar()) CheckOpPar<C4V_Any, false>(pCPos->bccX);
 				pCurVal->SetInt(-pCurVal->_getInt());
 				break;
 			// postfix (whithout second statement)
 			case AB_Inc1_Postfix: // ++
 			{
-				CheckOpPar<C4V_Int, false>(pCPos->bccX);
+				if (!IntOpPar<true>()) CheckOpPar<C4V_Int, false>(pCPos->bccX);
 				auto &orig = pCurVal->GetRefVal();
 				pCurVal->SetInt(orig._getInt());
 				++orig.GetData().Int;
@@ -481,7 +585,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_Dec1_Postfix: // --
 			{
-				CheckOpPar<C4V_Int, false>(pCPos->bccX);
+				if (!IntOpPar<true>()) CheckOpPar<C4V_Int, false>(pCPos->bccX);
 				auto &orig = pCurVal->GetRefVal();
 				pCurVal->SetInt(orig._getInt());
 				--orig.GetData().Int;
@@ -491,7 +595,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			// postfix
 			case AB_Pow: // **
 			{
-				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
+				if (!IntOpPars()) CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(Pow(pPar1->_getInt(), pPar2->_getInt()));
 				PopValue();
@@ -499,7 +603,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_Div: // /
 			{
-				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
+				if (!IntOpPars()) CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				if (pPar2->_getInt())
 					pPar1->SetInt(pPar1->_getInt() / pPar2->_getInt());
@@ -510,7 +614,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_Mul: // *
 			{
-				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
+				if (!IntOpPars()) CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(pPar1->_getInt() * pPar2->_getInt());
 				PopValue();
@@ -518,7 +622,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_Mod: // %
 			{
-				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
+				if (!IntOpPars()) CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				if (pPar2->_getInt())
 					pPar1->SetInt(pPar1->_getInt() % pPar2->_getInt());
@@ -529,7 +633,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_Sub: // -
 			{
-				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
+				if (!IntOpPars()) CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(pPar1->_getInt() - pPar2->_getInt());
 				PopValue();
@@ -537,7 +641,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_Sum: // +
 			{
-				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
+				if (!IntOpPars()) CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(pPar1->_getInt() + pPar2->_getInt());
 				PopValue();
@@ -545,7 +649,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_LeftShift: // <<
 			{
-				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
+				if (!IntOpPars()) CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(pPar1->_getInt() << pPar2->_getInt());
 				PopValue();
@@ -553,7 +657,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_RightShift: // >>
 			{
-				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
+				if (!IntOpPars()) CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(pPar1->_getInt() >> pPar2->_getInt());
 				PopValue();
@@ -561,7 +665,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_LessThan: // <
 			{
-				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
+				if (!IntOpPars()) CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetBool(pPar1->_getInt() < pPar2->_getInt());
 				PopValue();
@@ -569,7 +673,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_LessThanEqual: // <=
 			{
-				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
+				if (!IntOpPars()) CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetBool(pPar1->_getInt() <= pPar2->_getInt());
 				PopValue();
@@ -577,7 +681,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_GreaterThan: // >
 			{
-				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
+				if (!IntOpPars()) CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetBool(pPar1->_getInt() > pPar2->_getInt());
 				PopValue();
@@ -585,7 +689,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_GreaterThanEqual: // >=
 			{
-				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
+				if (!IntOpPars()) CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetBool(pPar1->_getInt() >= pPar2->_getInt());
 				PopValue();
@@ -637,6 +741,25 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 					}
 					default:
 					{
+						// left side is a string referenced by nothing but this value (e.g. the variable of s ..= x, or a temporary in a .. b .. c):
+						// append in place instead of copying it into a new string
+						if (pPar1->GetType() == C4V_String && (assignmentOperator || &pPar1->GetRefVal() == pPar1))
+						{
+							C4String *const lhs{pPar1->_getStr()};
+							if (lhs->iRefCnt == 1 && !lhs->Hold)
+							{
+								auto par2String = pPar2->toString();
+								if (!par2String)
+								{
+									throw C4AulExecError(pCurCtx->Obj, std::format("operator \"{}\" right side: can not convert \"{}\" to \"string\"!", operatorName, GetC4VName(pPar2->GetType())));
+								}
+
+								lhs->Append(*par2String);
+								PopValue();
+								break;
+							}
+						}
+
 						auto par1String = pPar1->toString();
 						if (!par1String)
 						{
@@ -658,7 +781,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_EqualIdent: // old ==
 			{
-				CheckOpPars(pCPos->bccX);
+				if (!IntOpPars()) CheckOpPars(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetBool(pPar1->Equals(*pPar2, C4AulScriptStrict::NONSTRICT));
 				PopValue();
@@ -666,7 +789,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_Equal: // new ==
 			{
-				CheckOpPars(pCPos->bccX);
+				if (!IntOpPars()) CheckOpPars(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetBool(pPar1->Equals(*pPar2, pCurCtx->Func->pOrgScript->Strict));
 				PopValue();
@@ -674,7 +797,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_NotEqualIdent: // old !=
 			{
-				CheckOpPars(pCPos->bccX);
+				if (!IntOpPars()) CheckOpPars(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetBool(!pPar1->Equals(*pPar2, C4AulScriptStrict::NONSTRICT));
 				PopValue();
@@ -682,7 +805,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_NotEqual: // new !=
 			{
-				CheckOpPars(pCPos->bccX);
+				if (!IntOpPars()) CheckOpPars(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetBool(!pPar1->Equals(*pPar2, pCurCtx->Func->pOrgScript->Strict));
 				PopValue();
@@ -708,7 +831,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_BitAnd: // &
 			{
-				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
+				if (!IntOpPars()) CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(pPar1->_getInt() & pPar2->_getInt());
 				PopValue();
@@ -716,7 +839,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_BitXOr: // ^
 			{
-				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
+				if (!IntOpPars()) CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(pPar1->_getInt() ^ pPar2->_getInt());
 				PopValue();
@@ -724,7 +847,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_BitOr: // |
 			{
-				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
+				if (!IntOpPars()) CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(pPar1->_getInt() | pPar2->_getInt());
 				PopValue();
@@ -749,7 +872,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 
 			case AB_PowIt: // **=
 			{
-				CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
+				if (!IntOpPars<true>()) CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->GetData().Int = Pow(pPar1->GetData().Int, pPar2->_getInt());
 				pPar1->HintType(C4V_Int);
@@ -758,7 +881,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_MulIt: // *=
 			{
-				CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
+				if (!IntOpPars<true>()) CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->GetData().Int *= pPar2->_getInt();
 				pCurVal->HintType(C4V_Int);
@@ -767,7 +890,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_DivIt: // /=
 			{
-				CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
+				if (!IntOpPars<true>()) CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->GetData().Int = pPar2->_getInt() ? pPar1->GetData().Int / pPar2->_getInt() : 0;
 				pPar1->HintType(C4V_Int);
@@ -776,7 +899,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_ModIt: // %=
 			{
-				CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
+				if (!IntOpPars<true>()) CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->GetData().Int = pPar2->_getInt() ? pPar1->GetData().Int % pPar2->_getInt() : 0;
 				pPar1->HintType(C4V_Int);
@@ -785,7 +908,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_Inc: // +=
 			{
-				CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
+				if (!IntOpPars<true>()) CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->GetData().Int += pPar2->_getInt();
 				pPar1->HintType(C4V_Int);
@@ -794,7 +917,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_Dec: // -=
 			{
-				CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
+				if (!IntOpPars<true>()) CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->GetData().Int -= pPar2->_getInt();
 				pPar1->HintType(C4V_Int);
@@ -803,7 +926,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_LeftShiftIt: // <<=
 			{
-				CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
+				if (!IntOpPars<true>()) CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->GetData().Int <<= pPar2->_getInt();
 				pPar1->HintType(C4V_Int);
@@ -812,7 +935,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_RightShiftIt: // >>=
 			{
-				CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
+				if (!IntOpPars<true>()) CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->GetData().Int >>= pPar2->_getInt();
 				pPar1->HintType(C4V_Int);
@@ -821,7 +944,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_AndIt: // &=
 			{
-				CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
+				if (!IntOpPars<true>()) CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->GetData().Int &= pPar2->_getInt();
 				pPar1->HintType(C4V_Int);
@@ -830,7 +953,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_OrIt: // |=
 			{
-				CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
+				if (!IntOpPars<true>()) CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->GetData().Int |= pPar2->_getInt();
 				pPar1->HintType(C4V_Int);
@@ -839,7 +962,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_XOrIt: // ^=
 			{
-				CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
+				if (!IntOpPars<true>()) CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->GetData().Int ^= pPar2->_getInt();
 				pPar1->HintType(C4V_Int);
@@ -1183,14 +1306,16 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				C4ValueHash *map = pCurVal[-2]._getMap();
 				if (!iterator)
 				{
-					iterator = new Iterator (map->begin());
+					// iterators of loops that were left at this slot or above are dead
+					ReleaseMapIterators(pCurVal);
+					iterator = MapIterators.emplace_back(pCurVal, std::make_unique<Iterator>(map->begin())).second.get();
 					pCurVal[0].SetInt(1);
 					pCurVal[0].GetData().Ref = reinterpret_cast<C4Value *>(iterator);
 				}
 				// No more entries?
 				if (*iterator == map->end())
 				{
-					delete iterator;
+					ReleaseMapIterators(pCurVal);
 					break;
 				}
 				// Get next
@@ -1325,7 +1450,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 		// Show
 		e.show();
 		// Trace
-		for (C4AulScriptContext *pCtx = pCurCtx; pCtx >= Contexts; pCtx--)
+		for (C4AulScriptContext *pCtx = pCurCtx; pCtx >= Contexts.Begin(); pCtx--)
 			pCtx->dump(" by: ");
 		// Unwind stack
 		C4Value *pUntil = nullptr;
@@ -1414,6 +1539,37 @@ static bool TryCheckConvertFunctionParameters(C4Object *const ctxObject, C4AulFu
 	}
 }
 
+C4Value C4AulExec::Exec(C4AulScriptFunc *pSFunc, C4Object *pObj, std::span<const C4Value> pars, bool fPassErrors, bool convertToAnyEagerly, bool convertNilToIntBool, bool onlyWarn)
+{
+	// Push parameters; missing ones are nil
+	assert(pars.size() <= C4AUL_MAX_Par);
+	const std::size_t parCount{std::min<std::size_t>(pars.size(), C4AUL_MAX_Par)};
+	C4Value *pPars = pCurVal + 1;
+	CheckOverflow(C4AUL_MAX_Par);
+	for (std::size_t i = 0; i < parCount; ++i)
+		(++pCurVal)->Set(pars[i]);
+	PushNullVals(C4AUL_MAX_Par - parCount);
+
+	// Check and convert them in place
+	bool ok;
+	try
+	{
+		ok = TryCheckConvertFunctionParameters(pObj, pSFunc, pPars, convertToAnyEagerly, convertNilToIntBool, fPassErrors, onlyWarn);
+	}
+	catch (...)
+	{
+		PopValuesUntil(pPars - 1);
+		throw;
+	}
+	if (!ok)
+	{
+		PopValuesUntil(pPars - 1);
+		return C4VNull;
+	}
+
+	return ExecPushed(pSFunc, pObj, pPars, fPassErrors, false);
+}
+
 C4AulBCC *C4AulExec::Call(C4AulFunc *pFunc, C4Value *pReturn, C4Value *pPars, C4Object *pObj, C4Def *pDef, bool globalContext)
 {
 	// No object given? Use current context
@@ -1424,7 +1580,7 @@ C4AulBCC *C4AulExec::Call(C4AulFunc *pFunc, C4Value *pReturn, C4Value *pPars, C4
 	}
 	else if (!pObj && !pDef)
 	{
-		assert(pCurCtx >= Contexts);
+		assert(pCurCtx >= Contexts.Begin());
 		pObj = pCurCtx->Obj;
 		pDef = pCurCtx->Def;
 	}
@@ -1548,7 +1704,7 @@ void C4AulExec::StartProfiling(C4AulScript *pProfiledScript)
 	tDirectExecStart = tNow; // in case profiling is started from DirectExec
 	tDirectExecTotal = 0;
 	pProfiledScript->ResetProfilerTimes();
-	for (C4AulScriptContext *pCtx = Contexts; pCtx <= pCurCtx; ++pCtx)
+	for (C4AulScriptContext *pCtx = Contexts.Begin(); pCtx <= pCurCtx; ++pCtx)
 		pCtx->tTime = tNow;
 }
 
@@ -1564,6 +1720,34 @@ void C4AulExec::StopProfiling()
 	Profiler.Show();
 }
 
+void C4AulExec::StartStackProfiling(const std::int32_t sampleInterval)
+{
+	stackProfiler = std::make_unique<C4AulStackProfiler>(sampleInterval);
+	// record running functions from now on
+	for (C4AulScriptContext *pCtx = Contexts.Begin(); pCtx <= pCurCtx; ++pCtx)
+		stackProfiler->Enter(*pCtx);
+}
+
+void C4AulStackProfiler::Start(const std::int32_t sampleInterval)
+{
+	AulExec.StartStackProfiling(sampleInterval);
+}
+
+void C4AulStackProfiler::Stop(const char *filename)
+{
+	const auto profiler = AulExec.StopStackProfiling();
+	if (!profiler) return;
+
+	const auto logger = Application.LogSystem.CreateLogger(Config.Logging.AulProfiler);
+	profiler->Show(*logger);
+
+	const std::string path{filename ? filename : Config.AtUserPath(C4CFN_ScriptProfile)};
+	if (profiler->SaveCollapsed(path.c_str()))
+		logger->info("Collapsed call stacks saved to {}", path);
+	else
+		logger->error("Could not save collapsed call stacks to {}", path);
+}
+
 void C4AulProfiler::StartProfiling(C4AulScript *pScript)
 {
 	AulExec.StartProfiling(pScript);
@@ -1607,7 +1791,7 @@ void C4AulProfiler::Show()
 	// done!
 }
 
-C4Value C4AulFunc::Exec(C4Object *pObj, const C4AulParSet &pPars, bool fPassErrors, bool nonStrict3WarnConversionOnly, bool convertNilToIntBool)
+C4Value C4AulFunc::Exec(C4Object *pObj, std::span<const C4Value> pPars, bool fPassErrors, bool nonStrict3WarnConversionOnly, bool convertNilToIntBool)
 {
 	// construct a dummy caller context
 	C4AulContext ctx;
@@ -1617,7 +1801,10 @@ C4Value C4AulFunc::Exec(C4Object *pObj, const C4AulParSet &pPars, bool fPassErro
 
 	const auto sFunc = SFunc();
 	const auto hasStrictNil = sFunc && sFunc->HasStrictNil();
-	auto pars = pPars;
+	// engine functions need a full parameter array
+	assert(pPars.size() <= C4AUL_MAX_Par);
+	C4AulParSet pars;
+	std::copy_n(pPars.begin(), std::min<std::size_t>(pPars.size(), C4AUL_MAX_Par), pars.Par);
 	if (TryCheckConvertFunctionParameters(pObj, this, pars.Par, !hasStrictNil, hasStrictNil && convertNilToIntBool, fPassErrors, nonStrict3WarnConversionOnly && !hasStrictNil))
 	{
 		// execute
@@ -1635,19 +1822,14 @@ C4Value C4AulScriptFunc::Exec(C4AulContext *pCtx, const C4Value pPars[], bool fP
 	return AulExec.Exec(this, pCtx->Obj, pPars, fPassErrors);
 }
 
-C4Value C4AulScriptFunc::Exec(C4Object *pObj, const C4AulParSet &pPars, bool fPassErrors, bool nonStrict3WarnConversionOnly, bool convertNilToIntBool)
+C4Value C4AulScriptFunc::Exec(C4Object *pObj, std::span<const C4Value> pPars, bool fPassErrors, bool nonStrict3WarnConversionOnly, bool convertNilToIntBool)
 {
 	// handle easiest case first
 	if (Owner->State != ASS_PARSED) return C4VNull;
 
+	// execute; the parameters are converted on the value stack
 	const auto isAtLeastStrict3 = HasStrictNil();
-	auto pars = pPars;
-	if (TryCheckConvertFunctionParameters(pObj, this, pars.Par, !isAtLeastStrict3, isAtLeastStrict3 && convertNilToIntBool, fPassErrors, nonStrict3WarnConversionOnly && !isAtLeastStrict3))
-	{
-		// execute
-		return AulExec.Exec(this, pObj, pars.Par, fPassErrors);
-	}
-	return C4VNull;
+	return AulExec.Exec(this, pObj, pPars, fPassErrors, !isAtLeastStrict3, isAtLeastStrict3 && convertNilToIntBool, nonStrict3WarnConversionOnly && !isAtLeastStrict3);
 }
 
 bool C4AulScriptFunc::HasStrictNil() const noexcept
@@ -1655,6 +1837,16 @@ bool C4AulScriptFunc::HasStrictNil() const noexcept
 	return pOrgScript->Strict >= C4AulScriptStrict::STRICT3;
 }
 
+namespace
+{
+	// DirectExec scripts are owned by their C4AulSnippet, not by the script they are registered to
+	class C4AulSnippetScript : public C4AulScript
+	{
+	public:
+		bool Delete() override { return false; }
+	};
+}
+
 C4Value C4AulScript::DirectExec(C4Object *pObj, const char *szScript, const char *szContext, bool fPassErrors, C4AulScriptStrict Strict)
 {
 #ifdef DEBUGREC_SCRIPT
@@ -1664,43 +1856,56 @@ C4Value C4AulScript::DirectExec(C4Object *pObj, const char *szScript, const char
 #endif
 	// profiler
 	AulExec.StartDirectExec();
-	// Create a new temporary script as child of this script
-	C4AulScript *pScript = new C4AulScript();
-	pScript->Script.Copy(szScript);
-	pScript->ScriptName = std::format("{} in {}", szContext, ScriptName);
-	pScript->Strict = Strict;
-	pScript->Temporary = true;
-	pScript->State = ASS_LINKED;
-	if (pObj)
+	// already compiled?
+	const C4AulSnippetCache::Key key{this, pObj ? pObj->Def : nullptr, Strict, szContext, szScript};
+	std::shared_ptr<C4AulSnippet> snippet{Engine->Snippets.Get(key)};
+	// this script has been cleared in the meantime?
+	if (snippet && snippet->Script->Owner != this) snippet.reset();
+	if (!snippet)
 	{
-		pScript->Def = pObj->Def;
-		pScript->LocalNamed = pObj->Def->Script.LocalNamed;
-	}
-	else
-	{
-		pScript->Def = nullptr;
-	}
-	pScript->Reg2List(Engine, this);
-	// Add a new function
-	C4AulScriptFunc *pFunc = new C4AulScriptFunc(pScript, "");
-	pFunc->Script = pScript->Script.getData();
-	pFunc->pOrgScript = pScript;
-	// Parse function
-	try
-	{
-		pScript->ParseFn(pFunc, true);
-	}
-	catch (const C4AulError &ex)
-	{
-		ex.show();
-		delete pFunc;
-		delete pScript;
-		return C4VNull;
+		// Create a new temporary script as child of this script
+		C4AulScript *pScript = new C4AulSnippetScript();
+		pScript->Script.Copy(szScript);
+		pScript->ScriptName = std::format("{} in {}", szContext, ScriptName);
+		pScript->Strict = Strict;
+		pScript->Temporary = true;
+		pScript->State = ASS_LINKED;
+		if (pObj)
+		{
+			pScript->Def = pObj->Def;
+			pScript->LocalNamed = pObj->Def->Script.LocalNamed;
+		}
+		else
+		{
+			pScript->Def = nullptr;
+		}
+		pScript->Reg2List(Engine, this);
+		// Add a new function
+		C4AulScriptFunc *pFunc = new C4AulScriptFunc(pScript, "");
+		pFunc->Script = pScript->Script.getData();
+		pFunc->pOrgScript = pScript;
+		pFunc->ResolveOverloaded();
+		// Parse function
+		const auto warnCnt = Engine->warnCnt;
+		try
+		{
+			pScript->ParseFn(pFunc, true);
+		}
+		catch (const C4AulError &ex)
+		{
+			ex.show();
+			delete pFunc;
+			delete pScript;
+			return C4VNull;
+		}
+		pFunc->Code = pScript->Code;
+		pScript->State = ASS_PARSED;
+		snippet = std::make_shared<C4AulSnippet>(pScript, pFunc);
+		// snippets with warnings are parsed again each time, so the warnings show up again
+		if (Engine->warnCnt == warnCnt) Engine->Snippets.Add(key, snippet);
 	}
-	pFunc->Code = pScript->Code;
-	pScript->State = ASS_PARSED;
-	// Execute. The TemporaryScript-parameter makes sure the script will be deleted later on.
-	C4Value vRetVal(AulExec.Exec(pFunc, pObj, nullptr, fPassErrors, true));
+	// Execute. The snippet is kept alive until execution is finished, even if it is evicted from the cache meanwhile.
+	C4Value vRetVal(AulExec.Exec(snippet->Func, pObj, nullptr, fPassErrors));
 	// profiler
 	AulExec.StopDirectExec();
 	return vRetVal;
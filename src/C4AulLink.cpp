@@ -19,6 +19,7 @@
 
 #include <C4Include.h>
 #include <C4Aul.h>
+#include <C4AulCodeCache.h>
 
 #include <C4Def.h>
 #include <C4Game.h>
@@ -268,8 +269,14 @@ void C4AulScriptEngine::Link(C4DefList *rDefs)
 		// parse script funcs descs
 		ParseDescs();
 
-		// parse the scripts to byte code
-		Parse();
+		// parse the scripts to byte code, unless it can be restored from the cache
+		C4AulCodeCache codeCache{*this};
+		if (!codeCache.Restore())
+		{
+			Parse();
+			// scripts with warnings or errors are not cached, so the messages show up again next time
+			if (!warnCnt && !errCnt) codeCache.Store();
+		}
 
 		// engine is always parsed (for global funcs)
 		State = ASS_PARSED;
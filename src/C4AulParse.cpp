@@ -22,9 +22,18 @@
 
 #include <C4Def.h>
 #include <C4Game.h>
+#include <C4ThreadPool.h>
 #include <C4Wrappers.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cinttypes>
+#include <latch>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #define DEBUG_BYTECODE_DUMP 0
 
@@ -218,6 +227,88 @@ private:
 	void AddLoopControl(bool fBreak);
 };
 
+namespace
+{
+	C4String *RegTableString(C4StringTable &strings, const char *const data, const bool hold)
+	{
+		C4String *string;
+		if (!(string = strings.FindString(data)))
+			string = strings.RegString(data);
+		if (hold) string->Hold = true;
+		return string;
+	}
+
+	// strings of a script parsed on a worker thread; the byte code refers to them by index + 1 until they are
+	// registered in script order after parsing, so the workers don't share the string table and its order doesn't
+	// depend on thread timing
+	struct C4AulParseStrings
+	{
+		std::vector<std::pair<std::string, bool>> Strings; // data, hold; in order of first use
+		std::unordered_map<std::string, std::size_t> Indices;
+
+		std::intptr_t Add(const char *const data, const bool hold)
+		{
+			const auto [it, inserted] = Indices.try_emplace(data, Strings.size());
+			if (inserted)
+				Strings.emplace_back(data, hold);
+			else if (hold)
+				Strings[it->second].second = true;
+			return static_cast<std::intptr_t>(it->second + 1);
+		}
+
+		std::vector<C4String *> Register(C4StringTable &strings) const
+		{
+			std::vector<C4String *> result;
+			result.reserve(Strings.size());
+			for (const auto &[data, hold] : Strings)
+				result.push_back(RegTableString(strings, data.c_str(), hold));
+			return result;
+		}
+	};
+
+	thread_local C4AulParseStrings *parseStrings{nullptr};
+
+	// warnings and errors of a script parsed on a worker thread, shown in script order after parsing
+	struct C4AulParseDiagnostics
+	{
+		std::vector<std::pair<C4AulError, std::string>> Messages; // message, additional note
+		int WarnCnt{0}, ErrCnt{0};
+
+		void Show()
+		{
+			for (const auto &[error, note] : Messages)
+			{
+				error.show();
+				if (!note.empty()) DebugLog(note);
+			}
+			Game.ScriptEngine.warnCnt += WarnCnt;
+			Game.ScriptEngine.errCnt += ErrCnt;
+		}
+	};
+
+	thread_local C4AulParseDiagnostics *parseDiagnostics{nullptr};
+
+	void ShowParseDiagnostic(const C4AulError &error, std::string note, const bool isError)
+	{
+		if (parseDiagnostics)
+		{
+			parseDiagnostics->Messages.emplace_back(error, std::move(note));
+			++(isError ? parseDiagnostics->ErrCnt : parseDiagnostics->WarnCnt);
+			return;
+		}
+
+		error.show();
+		if (!note.empty()) DebugLog(note);
+		++(isError ? Game.ScriptEngine.errCnt : Game.ScriptEngine.warnCnt);
+	}
+
+	C4String *RegParserString(C4StringTable &strings, const char *const data, const bool hold)
+	{
+		if (parseStrings) return reinterpret_cast<C4String *>(parseStrings->Add(data, hold));
+		return RegTableString(strings, data, hold);
+	}
+}
+
 void C4AulScript::Warn(const std::string_view msg, const char *pIdtf)
 {
 	C4AulParseError{this, msg, pIdtf, true}.show();
@@ -229,12 +320,12 @@ void C4AulParseState::Warn(const std::string_view msg, const char *pIdtf)
 	// do not show errors for System.c4g scripts that appear to be pure #appendto scripts
 	if (Fn && !Fn->Owner->Def && !Fn->Owner->Appends.empty()) return;
 
-	C4AulParseError{this, msg, pIdtf, true}.show();
+	std::string note;
 	if (Fn && Fn->pOrgScript != a)
 	{
-		DebugLog("  (as #appendto/#include to {})", Fn->Owner->ScriptName);
+		note = std::format("  (as #appendto/#include to {})", Fn->Owner->ScriptName);
 	}
-	++Game.ScriptEngine.warnCnt;
+	ShowParseDiagnostic(C4AulParseError{this, msg, pIdtf, true}, std::move(note), false);
 }
 
 void C4AulParseState::StrictError(const std::string_view message, C4AulScriptStrict errorSince, const char *identifier)
@@ -535,7 +626,7 @@ C4AulTokenType C4AulParseState::GetNextToken(char *pToken, std::intptr_t *pInt,
 	};
 	TokenGetState State = TGS_None;
 
-	static char StrBuff[C4AUL_MAX_String + 1];
+	static thread_local char StrBuff[C4AUL_MAX_String + 1];
 	char *pStrPos = StrBuff;
 
 	const auto strictLevel = Fn ? Fn->pOrgScript->Strict : a->Strict;
@@ -775,10 +866,7 @@ C4AulTokenType C4AulParseState::GetNextToken(char *pToken, std::intptr_t *pInt,
 				// no string expected?
 				if (HoldStrings == Discard) return ATT_STRING;
 				// reg string (if not already done so)
-				C4String *pString;
-				if (!(pString = a->Engine->Strings.FindString(StrBuff)))
-					pString = a->Engine->Strings.RegString(StrBuff);
-				if (HoldStrings == Hold) pString->Hold = 1;
+				C4String *pString = RegParserString(a->Engine->Strings, StrBuff, HoldStrings == Hold);
 				// return pointer on string object
 				*pInt = reinterpret_cast<std::intptr_t>(pString);
 				return ATT_STRING;
@@ -1399,13 +1487,6 @@ void C4AulParseState::UnexpectedToken(const char *Expected)
 
 void C4AulScript::ParseFn(C4AulScriptFunc *Fn, bool fExprOnly)
 {
-	// check if fn overloads other fn (all func tables are built now)
-	// *MUST* check Fn->Owner-list, because it may be the engine (due to linked globals)
-	if (Fn->OwnerOverloaded = Fn->Owner->GetOverloadedFunc(Fn))
-		if (Fn->Owner == Fn->OwnerOverloaded->Owner)
-			Fn->OwnerOverloaded->OverloadedBy = Fn;
-	// reset pointer to next same-named func (will be set in AfterLink)
-	Fn->NextSNFunc = nullptr;
 	// store byte code pos
 	// (relative position to code start; code pointer may change while
 	//  parsing)
@@ -2425,10 +2506,7 @@ void C4AulParseState::Parse_Map()
 			{
 				case ATT_IDTF:
 				{
-					C4String *string;
-					if (!(string = a->Engine->Strings.FindString(Idtf)))
-						string = a->Engine->Strings.RegString(Idtf);
-					if (Type == PARSER) string->Hold = true;
+					C4String *string = RegParserString(a->Engine->Strings, Idtf, Type == PARSER);
 					AddBCC(AB_STRING, reinterpret_cast<std::intptr_t>(string));
 					Shift();
 					break;
@@ -2834,15 +2912,17 @@ void C4AulParseState::Parse_Expression(int iParentPrio)
 				// check for global constant (static const)
 				// global constants have lowest priority for backwards compatibility
 				// it is now allowed to have functional overloads of these constants
-				C4Value val;
-				if (a->Engine->GetGlobalConstant(Idtf, &val))
+				// not copied, so the ref count of string constants isn't touched while parsing in parallel;
+				// string constants are registered like literals so their byte code holds a parser string index as well
+				if (const std::int32_t constIndex{a->Engine->GlobalConstNames.GetItemNr(Idtf)}; constIndex >= 0)
 				{
+					const C4Value &val{a->Engine->GlobalConsts[constIndex]};
 					// store as direct constant
 					switch (val.GetType())
 					{
 					case C4V_Int:    AddBCC(AB_INT, val._getInt()); break;
 					case C4V_Bool:   AddBCC(AB_BOOL, val._getBool()); break;
-					case C4V_String: AddBCC(AB_STRING, reinterpret_cast<std::intptr_t>(val.GetData().Str)); break;
+					case C4V_String: AddBCC(AB_STRING, reinterpret_cast<std::intptr_t>(RegParserString(a->Engine->Strings, val._getStr()->Data.getData(), true))); break;
 					case C4V_C4ID:   AddBCC(AB_C4ID, val._getC4ID()); break;
 					case C4V_Any:    AddBCC(AB_NIL); break;
 					default:
@@ -3134,10 +3214,7 @@ bool C4AulParseState::Parse_Expression3()
 			Shift();
 			if (TokenType == ATT_IDTF)
 			{
-				C4String *string;
-				if (!(string = a->Engine->Strings.FindString(Idtf)))
-					string = a->Engine->Strings.RegString(Idtf);
-				if (Type == PARSER) string->Hold = true;
+				C4String *string = RegParserString(a->Engine->Strings, Idtf, Type == PARSER);
 				AddBCC(AB_MAPA_R, reinterpret_cast<std::intptr_t>(string));
 				Shift();
 				break;
@@ -3507,43 +3584,98 @@ loopEnd:
 	return result;
 }
 
+C4AulScriptFunc *C4AulScript::GetParsedFunc(C4AulFunc *const f)
+{
+	// check whether it's a script func, or linked to one
+	C4AulScriptFunc *Fn;
+	if (!(Fn = f->SFunc()))
+	{
+		if (f->LinkedTo) Fn = f->LinkedTo->SFunc();
+		// do only parse global funcs, because otherwise, the #append-links get parsed (->code overflow)
+		if (Fn) if (Fn->Owner != Engine) Fn = nullptr;
+	}
+	return Fn;
+}
+
+void C4AulScript::CollectParseScripts(std::vector<C4AulScript *> &scripts)
+{
+	// children first
+	for (C4AulScript *s = Child0; s; s = s->Next)
+		s->CollectParseScripts(scripts);
+	// don't parse global funcs again, as they're parsed already through links
+	if (State == ASS_LINKED && this != Engine)
+		scripts.push_back(this);
+}
+
 bool C4AulScript::Parse()
 {
-#if DEBUG_BYTECODE_DUMP
-	const auto logger = Application.LogSystem.GetOrCreate("C4AulScript");
+	std::vector<C4AulScript *> scripts;
+	CollectParseScripts(scripts);
+	if (scripts.empty()) return false;
 
-	C4ScriptHost *scripthost{nullptr};
-	if (Def) scripthost = &Def->Script;
-	if (scripthost) logger->info("parsing {}...", scripthost->GetFilePath());
-	else logger->info("parsing unknown..");
-#endif
+	// overloads are resolved up front, because they modify funcs of other scripts
+	for (C4AulScript *const s : scripts)
+	{
+		// delete existing code
+		delete[] s->Code;
+		s->CodeSize = s->CodeBufSize = 0;
+		// reset code and script pos
+		s->CPos = s->Code;
 
-	// parse children
-	C4AulScript *s = Child0;
-	while (s) { s->Parse(); s = s->Next; }
-	// check state
-	if (State != ASS_LINKED) return false;
-	// don't parse global funcs again, as they're parsed already through links
-	if (this == Engine) return false;
-	// delete existing code
-	delete[] Code;
-	CodeSize = CodeBufSize = 0;
-	// reset code and script pos
-	CPos = Code;
+		for (C4AulFunc *f = s->Func0; f; f = f->Next)
+			if (C4AulScriptFunc *const Fn{s->GetParsedFunc(f)})
+				Fn->ResolveOverloaded();
+	}
 
-	// parse script funcs
-	C4AulFunc *f;
-	for (f = Func0; f; f = f->Next)
+	// the byte code of each script only depends on the (already built) func tables, so scripts are parsed in parallel;
+	// diagnostics and strings are collected per script and shown or registered in order afterwards
+	std::vector<C4AulParseDiagnostics> diagnostics(scripts.size());
+	std::vector<C4AulParseStrings> strings(scripts.size());
+	std::atomic_size_t nextScript{0};
+	const auto parseScripts = [&scripts, &diagnostics, &strings, &nextScript]
 	{
-		// check whether it's a script func, or linked to one
-		C4AulScriptFunc *Fn;
-		if (!(Fn = f->SFunc()))
+		for (std::size_t i; (i = nextScript.fetch_add(1, std::memory_order_relaxed)) < scripts.size(); )
 		{
-			if (f->LinkedTo) Fn = f->LinkedTo->SFunc();
-			// do only parse global funcs, because otherwise, the #append-links get parsed (->code overflow)
-			if (Fn) if (Fn->Owner != Engine) Fn = nullptr;
+			parseDiagnostics = &diagnostics[i];
+			parseStrings = &strings[i];
+			scripts[i]->ParseFuncs();
 		}
-		if (Fn)
+		parseDiagnostics = nullptr;
+		parseStrings = nullptr;
+	};
+
+	// not worth it for a handful of scripts
+	constexpr std::size_t MinScriptsPerWorker{16};
+	const auto &threadPool = C4ThreadPool::Global;
+	const std::size_t workerCount{threadPool ? std::min<std::size_t>(threadPool->GetThreadCount(), scripts.size() / MinScriptsPerWorker) : 0};
+	std::latch workersDone{static_cast<std::ptrdiff_t>(workerCount)};
+	for (std::size_t i = 0; i < workerCount; ++i)
+	{
+		threadPool->SubmitCallback([&parseScripts, &workersDone]
+		{
+			parseScripts();
+			workersDone.count_down();
+		});
+	}
+	parseScripts();
+	workersDone.wait();
+
+	for (std::size_t i = 0; i < scripts.size(); ++i)
+	{
+		diagnostics[i].Show();
+		scripts[i]->ResolveStrings(strings[i].Register(Engine->Strings));
+		scripts[i]->FinishParse();
+	}
+
+	return true;
+}
+
+void C4AulScript::ParseFuncs()
+{
+	// parse script funcs
+	for (C4AulFunc *f = Func0; f; f = f->Next)
+	{
+		if (C4AulScriptFunc *const Fn{GetParsedFunc(f)})
 		{
 			// parse function
 			try
@@ -3555,13 +3687,12 @@ bool C4AulScript::Parse()
 				// do not show errors for System.c4g scripts that appear to be pure #appendto scripts
 				if (Fn->Owner->Def || Fn->Owner->Appends.empty())
 				{
-					// show
-					err.show();
-					// show a warning if the error is in a remote script
+					// show a note if the error is in a remote script
+					std::string note;
 					if (Fn->pOrgScript != this)
-						DebugLog("  (as #appendto/#include to {})", Fn->Owner->ScriptName);
-					// and count (visible only ;) )
-					++Game.ScriptEngine.errCnt;
+						note = std::format("  (as #appendto/#include to {})", Fn->Owner->ScriptName);
+					// show and count (visible only ;) )
+					ShowParseDiagnostic(err, std::move(note), true);
 				}
 				// make all jumps that don't have their destination yet jump here
 				// std::intptr_t to make it work on 64bit
@@ -3583,19 +3714,39 @@ bool C4AulScript::Parse()
 
 	// add eof chunk
 	AddBCC(AB_EOF);
+}
 
-	// calc absolute code addresses for script funcs
-	for (f = Func0; f; f = f->Next)
+void C4AulScript::ResolveStrings(const std::vector<C4String *> &strings)
+{
+	for (C4AulBCC &bcc : std::span{Code, static_cast<std::size_t>(CodeSize)})
 	{
-		C4AulScriptFunc *Fn;
-		if (!(Fn = f->SFunc()))
+		switch (bcc.bccType)
 		{
-			if (f->LinkedTo) Fn = f->LinkedTo->SFunc();
-			if (Fn) if (Fn->Owner != Engine) Fn = nullptr;
+		case AB_STRING: case AB_MAPA_R: case AB_MAPA_V:
+			if (bcc.bccX) bcc.bccX = reinterpret_cast<std::intptr_t>(strings[bcc.bccX - 1]);
+			break;
+		default:
+			break;
 		}
-		if (Fn)
-			Fn->Code = Code + reinterpret_cast<std::intptr_t>(Fn->Code);
 	}
+}
+
+void C4AulScript::FinishParse()
+{
+#if DEBUG_BYTECODE_DUMP
+	const auto logger = Application.LogSystem.GetOrCreate("C4AulScript");
+
+	C4ScriptHost *scripthost{nullptr};
+	if (Def) scripthost = &Def->Script;
+	if (scripthost) logger->info("parsed {}", scripthost->GetFilePath());
+	else logger->info("parsed unknown");
+#endif
+
+	// calc absolute code addresses for script funcs
+	C4AulFunc *f;
+	for (f = Func0; f; f = f->Next)
+		if (C4AulScriptFunc *const Fn{GetParsedFunc(f)})
+			Fn->Code = Code + reinterpret_cast<std::intptr_t>(Fn->Code);
 
 	// save line count
 	Engine->lineCnt += SGetLine(Script.getData(), Script.getPtr(Script.getLength()));
@@ -3604,13 +3755,7 @@ bool C4AulScript::Parse()
 #if DEBUG_BYTECODE_DUMP
 	for (f = Func0; f; f = f->Next)
 	{
-		C4AulScriptFunc *Fn;
-		if (!(Fn = f->SFunc()))
-		{
-			if (f->LinkedTo) Fn = f->LinkedTo->SFunc();
-			if (Fn) if (Fn->Owner != Engine) Fn = nullptr;
-		}
-		if (Fn)
+		if (C4AulScriptFunc *const Fn{GetParsedFunc(f)})
 		{
 			logger->info("{}:", Fn->Name);
 			for (C4AulBCC *pBCC = Fn->Code;; pBCC++)
@@ -3634,8 +3779,6 @@ bool C4AulScript::Parse()
 
 	// finished
 	State = ASS_PARSED;
-
-	return true;
 }
 
 void C4AulScript::ParseDescs()
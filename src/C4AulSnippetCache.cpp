@@ -0,0 +1,76 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// cache for code compiled by C4AulScript::DirectExec
+
+#include <C4Include.h>
+#include <C4AulSnippetCache.h>
+
+#include <C4Aul.h>
+
+#include <functional>
+
+C4AulSnippet::~C4AulSnippet()
+{
+	// deletes Func, too
+	delete Script;
+}
+
+std::size_t C4AulSnippetCache::KeyHash::operator()(const Key &key) const
+{
+	std::size_t hash{std::hash<std::string>{}(key.Source)};
+	const auto combine = [&hash](const std::size_t value)
+	{
+		hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+	};
+	combine(std::hash<std::string>{}(key.Context));
+	combine(std::hash<C4AulScript *>{}(key.Owner));
+	combine(std::hash<C4Def *>{}(key.Def));
+	combine(std::hash<C4AulScriptStrict>{}(key.Strict));
+	return hash;
+}
+
+std::shared_ptr<C4AulSnippet> C4AulSnippetCache::Get(const Key &key)
+{
+	const auto it = index.find(key);
+	if (it == index.end()) return nullptr;
+	// move to front
+	entries.splice(entries.begin(), entries, it->second);
+	return it->second->second;
+}
+
+void C4AulSnippetCache::Add(const Key &key, std::shared_ptr<C4AulSnippet> snippet)
+{
+	if (const auto it = index.find(key); it != index.end())
+	{
+		entries.erase(it->second);
+		index.erase(it);
+	}
+
+	entries.emplace_front(key, std::move(snippet));
+	index.emplace(key, entries.begin());
+
+	if (entries.size() > MaxEntries)
+	{
+		index.erase(entries.back().first);
+		entries.pop_back();
+	}
+}
+
+void C4AulSnippetCache::Clear()
+{
+	index.clear();
+	entries.clear();
+}
@@ -0,0 +1,80 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// cache for code compiled by C4AulScript::DirectExec
+
+#pragma once
+
+#include "C4AulScriptStrict.h"
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+class C4AulScript;
+class C4AulScriptFunc;
+class C4Def;
+
+// compiled DirectExec code (eval, menu commands, console scripts)
+struct C4AulSnippet
+{
+	C4AulScript *Script; // temporary script holding Func; registered as child of the script it is executed in
+	C4AulScriptFunc *Func;
+
+	C4AulSnippet(C4AulScript *script, C4AulScriptFunc *func) : Script{script}, Func{func} {}
+	~C4AulSnippet();
+
+	C4AulSnippet(const C4AulSnippet &) = delete;
+	C4AulSnippet &operator=(const C4AulSnippet &) = delete;
+};
+
+// LRU cache of compiled DirectExec code, so repeatedly executed strings are only parsed once.
+// Snippets reference funcs and strings of the linked scripts, so the cache must be cleared whenever the engine is unlinked.
+// Running executions share ownership of their snippet, so evicted snippets stay alive until they are finished.
+class C4AulSnippetCache
+{
+public:
+	struct Key
+	{
+		C4AulScript *Owner;
+		C4Def *Def; // def of the context object, whose local variables are visible
+		C4AulScriptStrict Strict;
+		std::string Context;
+		std::string Source;
+
+		bool operator==(const Key &other) const = default;
+	};
+
+public:
+	std::shared_ptr<C4AulSnippet> Get(const Key &key); // returns nullptr if not cached
+	void Add(const Key &key, std::shared_ptr<C4AulSnippet> snippet); // replaces an existing entry
+	void Clear();
+
+private:
+	static constexpr std::size_t MaxEntries = 128;
+
+	struct KeyHash
+	{
+		std::size_t operator()(const Key &key) const;
+	};
+
+	using Entry = std::pair<Key, std::shared_ptr<C4AulSnippet>>;
+
+	std::list<Entry> entries; // most recently used first
+	std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index;
+};
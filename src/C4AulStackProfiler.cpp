@@ -0,0 +1,157 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// call stack profiler for C4Script
+
+#include <C4Include.h>
+#include <C4AulStackProfiler.h>
+
+#include <C4Aul.h>
+#include <C4Object.h>
+
+#include <algorithm>
+#include <format>
+#include <map>
+#include <utility>
+
+C4AulStackProfiler::C4AulStackProfiler(const std::int32_t sampleInterval)
+	: sampleInterval{std::max(sampleInterval, 1)}
+{
+	nodes.push_back(Node{0, "engine", 0});
+}
+
+void C4AulStackProfiler::Enter(const C4AulScriptContext &context)
+{
+	if (skipDepth)
+	{
+		++skipDepth;
+		return;
+	}
+	// new call from the engine: sample it?
+	if (stack.empty() && rootCalls++ % sampleInterval)
+	{
+		skipDepth = 1;
+		return;
+	}
+
+	const std::size_t parent{stack.empty() ? 0 : stack.back().Node};
+	const auto [it, inserted] = nodes[parent].Children.try_emplace(context.Func, nodes.size());
+	const std::size_t node{it->second};
+	if (inserted)
+	{
+		C4AulScript *const owner{context.Func ? context.Func->Owner : nullptr};
+		nodes.push_back(Node{parent, context.Func ? context.Func->GetFullName() : "(unknown)", owner && owner->Def ? owner->Def->id : 0});
+	}
+
+	std::int32_t object{0};
+	if (context.Obj)
+	{
+		object = context.Obj->Number;
+		if (!objects.contains(object))
+			objects.emplace(object, ObjectEntry{context.Obj->GetName(), context.Obj->id});
+	}
+
+	stack.push_back(Frame{node, object, Clock::now(), 0});
+}
+
+void C4AulStackProfiler::Leave()
+{
+	if (skipDepth)
+	{
+		--skipDepth;
+		return;
+	}
+	// context was pushed before the profiler has been started
+	if (stack.empty()) return;
+
+	const Frame frame{stack.back()};
+	stack.pop_back();
+
+	const auto totalNs = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - frame.Start).count());
+	const std::uint64_t selfNs{totalNs - std::min(frame.ChildNs, totalNs)};
+
+	Node &node{nodes[frame.Node]};
+	node.TotalNs += totalNs;
+	node.SelfNs += selfNs;
+	++node.Calls;
+
+	if (!stack.empty()) stack.back().ChildNs += totalNs;
+
+	if (frame.Object)
+	{
+		ObjectEntry &object{objects[frame.Object]};
+		object.SelfNs += selfNs;
+		++object.Calls;
+	}
+}
+
+void C4AulStackProfiler::Show(spdlog::logger &logger) const
+{
+	const auto showTop = [&logger](auto entries, const auto &formatEntry)
+	{
+		std::ranges::sort(entries, std::greater{}, [](const auto &entry) { return entry.second.first; });
+		if (entries.size() > MaxShownEntries) entries.resize(MaxShownEntries);
+		for (const auto &entry : entries)
+			logger.info("{:10.3f}ms\t{:8}\t{}", entry.second.first / 1e6, entry.second.second, formatEntry(entry.first));
+	};
+
+	// self time and calls by definition
+	std::map<C4ID, std::pair<std::uint64_t, std::uint64_t>> defs;
+	for (const Node &node : nodes)
+	{
+		if (!node.Calls) continue;
+		auto &def = defs[node.Def];
+		def.first += node.SelfNs;
+		def.second += node.Calls;
+	}
+
+	logger.info("Script call stack profiler: {} of {} engine calls sampled", (rootCalls + sampleInterval - 1) / sampleInterval, rootCalls);
+	logger.info("==============================");
+	logger.info("Self time by definition:");
+	showTop(std::vector<std::pair<C4ID, std::pair<std::uint64_t, std::uint64_t>>>(defs.begin(), defs.end()), [](const C4ID id) { return id ? std::string{C4IdText(id)} : std::string{"(global)"}; });
+
+	// self time and calls by object
+	std::vector<std::pair<std::int32_t, std::pair<std::uint64_t, std::uint64_t>>> objectTimes;
+	objectTimes.reserve(objects.size());
+	for (const auto &[number, object] : objects)
+		objectTimes.emplace_back(number, std::pair{object.SelfNs, object.Calls});
+
+	logger.info("Self time by object:");
+	showTop(std::move(objectTimes), [this](const std::int32_t number)
+	{
+		const ObjectEntry &object{objects.at(number)};
+		return std::format("{} ({}) #{}", object.Name, C4IdText(object.Def), number);
+	});
+	logger.info("==============================");
+}
+
+bool C4AulStackProfiler::SaveCollapsed(const char *const filename) const
+{
+	std::string output;
+	for (const auto &[func, child] : nodes[0].Children)
+		AppendCollapsed(output, child, "");
+	return StdStrBuf{output.c_str(), output.size(), false}.SaveToFile(filename);
+}
+
+void C4AulStackProfiler::AppendCollapsed(std::string &output, const std::size_t node, const std::string &path) const
+{
+	const Node &current{nodes[node]};
+	const std::string stackPath{path.empty() ? current.Name : std::format("{};{}", path, current.Name)};
+	if (const std::uint64_t selfUs{current.SelfNs / 1000}; selfUs)
+		output += std::format("{} {}\n", stackPath, selfUs);
+
+	for (const auto &[func, child] : current.Children)
+		AppendCollapsed(output, child, stackPath);
+}
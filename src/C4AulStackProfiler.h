@@ -0,0 +1,89 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// call stack profiler for C4Script
+
+#pragma once
+
+#include "C4Id.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace spdlog { class logger; }
+
+class C4AulScriptFunc;
+struct C4AulScriptContext;
+
+// Records self and total time of script functions per call chain, following the context stack of C4AulExec.
+// Unlike C4AulProfiler, it tells which callers make a function hot. To bound the overhead, only every n-th
+// call from the engine into script (with its whole call tree) can be recorded.
+// Results are written as collapsed stacks for flamegraph tools, plus a breakdown by definition and object.
+class C4AulStackProfiler
+{
+public:
+	C4AulStackProfiler(std::int32_t sampleInterval);
+
+	void Enter(const C4AulScriptContext &context); // context has been pushed
+	void Leave(); // context is about to be popped
+
+	void Show(spdlog::logger &logger) const;
+	bool SaveCollapsed(const char *filename) const; // one "caller;callee self-microseconds" line per call chain
+
+	static void Start(std::int32_t sampleInterval);
+	static void Stop(const char *filename); // nullptr: save to user path
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	static constexpr std::size_t MaxShownEntries = 20;
+
+	struct Node
+	{
+		std::size_t Parent;
+		std::string Name;
+		C4ID Def;
+		std::unordered_map<const C4AulScriptFunc *, std::size_t> Children{};
+		std::uint64_t SelfNs{0}, TotalNs{0}, Calls{0};
+	};
+
+	struct Frame
+	{
+		std::size_t Node;
+		std::int32_t Object; // object number; 0 for none
+		Clock::time_point Start;
+		std::uint64_t ChildNs;
+	};
+
+	struct ObjectEntry
+	{
+		std::string Name;
+		C4ID Def;
+		std::uint64_t SelfNs{0}, Calls{0};
+	};
+
+	std::int32_t sampleInterval;
+	std::uint64_t rootCalls{0};
+	std::size_t skipDepth{0}; // nesting depth inside a call tree which is not sampled
+	std::vector<Node> nodes; // call tree; nodes[0] is the engine
+	std::vector<Frame> stack;
+	std::unordered_map<std::int32_t, ObjectEntry> objects;
+
+	void AppendCollapsed(std::string &output, std::size_t node, const std::string &path) const;
+};
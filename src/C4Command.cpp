@@ -1094,7 +1094,7 @@ bool C4Command::GetTryEnter()
 	// No minimum con knowledge vehicles/items: fail
 	if (Target->Contained && CheckMinimumCon(Target)) { /* fail??! */ return false; }
 	// Target contained and container has RejectContents: fail
-	if (Target->Contained && Target->Contained->Call(PSF_RejectContents)) { Finish(); return false; }
+	if (Target->Contained && Target->Contained->Call(C4DefScriptHost::CB_RejectContents)) { Finish(); return false; }
 	// Collection limit: drop other object
 	// return after drop, so multiple objects may be dropped
 	if (cObj->Def->CollectionLimit && (cObj->Contents.ObjectCount() >= cObj->Def->CollectionLimit))
@@ -122,6 +122,10 @@
 #define C4CFN_TempTitle        "~Title.tmp"
 #define C4CFN_TempPlayer       "~plr.tmp"
 
+#define C4CFN_ScriptCache "ScriptCache"
+#define C4CFN_NetResCache "ResCache" // in network path
+#define C4CFN_ScriptProfile "ScriptProfile.txt"
+
 #define C4CFN_DefFiles        "*.c4d"
 #define C4CFN_PlayerFiles     "*.c4p"
 #define C4CFN_MaterialFiles   "*.c4m"
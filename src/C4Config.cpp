@@ -141,6 +141,7 @@ void C4ConfigDeveloper::CompileFunc(StdCompiler *pComp)
 {
 	pComp->Value(mkNamingAdapt(AutoFileReload, "AutoFileReload", true, false, true));
 	pComp->Value(mkNamingAdapt(ConsoleScriptStrictness, "ConsoleScriptStrictness", ConsoleScriptStrictnessWrapper{ConsoleScriptStrictnessWrapper::MaxStrictSentinel}));
+	pComp->Value(mkNamingAdapt(ScriptBytecodeCache, "ScriptBytecodeCache", true));
 }
 
 void C4ConfigGraphics::CompileFunc(StdCompiler *pComp)
@@ -235,6 +236,7 @@ void C4ConfigSound::CompileFunc(StdCompiler *pComp)
 void C4ConfigNetwork::CompileFunc(StdCompiler *pComp)
 {
 	pComp->Value(mkNamingAdapt(ControlRate,           "ControlRate",           2,         false, true));
+	pComp->Value(mkNamingAdapt(AutoControlRate,       "AutoControlRate",       true,      false, true));
 	pComp->Value(mkNamingAdapt(s(WorkPath),           "WorkPath",              "Network", false, true));
 	pComp->Value(mkNamingAdapt(NoRuntimeJoin,         "NoRuntimeJoin",         true,      false, true));
 	pComp->Value(mkNamingAdapt(MaxResSearchRecursion, "MaxResSearchRecursion", 1,         false, true));
@@ -249,6 +251,7 @@ void C4ConfigNetwork::CompileFunc(StdCompiler *pComp)
 	pComp->Value(mkNamingAdapt(LocalName,          "LocalName",          "Unknown",      false, true));
 	pComp->Value(mkNamingAdapt(Nick,               "Nick",               "",             false, true));
 	pComp->Value(mkNamingAdapt(MaxLoadFileSize,    "MaxLoadFileSize", 100 * 1024 * 1024, false, true));
+	pComp->Value(mkNamingAdapt(ResCacheSize,       "ResCacheSize",       1024,           false, true));
 
 	pComp->Value(mkNamingAdapt(MasterServerSignUp,        "MasterServerSignUp",     true,   false, true));
 	pComp->Value(mkNamingAdapt(MasterReferencePeriod,     "MasterReferencePeriod",  120,    false, true));
@@ -116,6 +116,7 @@ public:
 public:
 	bool AutoFileReload;
 	ConsoleScriptStrictnessWrapper ConsoleScriptStrictness;
+	bool ScriptBytecodeCache; // keep compiled scripts in the user path to speed up linking
 
 	void CompileFunc(StdCompiler *pComp);
 };
@@ -195,6 +196,7 @@ class C4ConfigNetwork
 {
 public:
 	int32_t ControlRate;
+	bool AutoControlRate; // raise control rate while the connections are too slow for it
 	bool NoRuntimeJoin;
 	int32_t MaxResSearchRecursion;
 	char WorkPath[CFG_MaxString + 1];
@@ -208,6 +210,7 @@ public:
 	ValidatedStdStrBuf<C4InVal::VAL_NameNoEmpty> LocalName;
 	ValidatedStdStrBuf<C4InVal::VAL_NameAllowEmpty> Nick;
 	int32_t MaxLoadFileSize;
+	int32_t ResCacheSize; // (MB) - loaded ressources kept for later games; 0 to disable
 	char LastPassword[CFG_MaxString + 1];
 	char ServerAddress[CFG_MaxString + 1];
 	char AlternateServerAddress[CFG_MaxString + 1];
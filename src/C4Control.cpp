@@ -143,6 +143,14 @@ void C4ControlSet::Execute(const std::shared_ptr<spdlog::logger> &) const
 		Game.GraphicsSystem.FlashMessage(LoadResStr(C4ResStrTableKey::IDS_NET_CONTROLRATE, Game.Control.ControlRate).c_str());
 		break;
 
+	case C4CVT_AutoControlRate: // control rate picked by the network control
+		// host only
+		if (!HostControl()) break;
+		Game.Control.ControlRate = BoundBy<int32_t>(iData, 1, C4MaxControlRate);
+		Game.Parameters.ControlRate = Game.Control.ControlRate;
+		Game.GraphicsSystem.FlashMessage(LoadResStr(C4ResStrTableKey::IDS_NET_AUTOCONTROLRATE, Game.Control.ControlRate).c_str());
+		break;
+
 	case C4CVT_DisableDebug: // force debug mode disabled
 	{
 		if (Game.DebugMode)
@@ -314,8 +322,8 @@ void C4ControlScript::Execute(const std::shared_ptr<spdlog::logger> &) const
 
 void C4ControlScript::CompileFunc(StdCompiler *pComp)
 {
-	pComp->Value(mkNamingAdapt(iTargetObj, "TargetObj", -1));
-	pComp->Value(mkNamingAdapt(Strict,     "Strict",    C4AulScriptStrict::MAXSTRICT));
+	pComp->Value(mkNamingAdapt(mkIntPackAdapt(iTargetObj), "TargetObj", -1));
+	pComp->Value(mkNamingAdapt(Strict,                     "Strict",    C4AulScriptStrict::MAXSTRICT));
 
 	if (pComp->isCompiler())
 	{
@@ -369,14 +377,14 @@ void C4ControlPlayerSelect::Execute(const std::shared_ptr<spdlog::logger> &) con
 
 void C4ControlPlayerSelect::CompileFunc(StdCompiler *pComp)
 {
-	pComp->Value(mkNamingAdapt(iPlr,    "Player", -1));
-	pComp->Value(mkNamingAdapt(iObjCnt, "ObjCnt",  0));
+	pComp->Value(mkNamingAdapt(mkIntPackAdapt(iPlr),    "Player", -1));
+	pComp->Value(mkNamingAdapt(mkIntPackAdapt(iObjCnt), "ObjCnt",  0));
 	// Compile array
 	if (pComp->isCompiler())
 	{
 		delete[] pObjNrs; pObjNrs = new int32_t[iObjCnt];
 	}
-	pComp->Value(mkNamingAdapt(mkArrayAdaptS(pObjNrs, iObjCnt), "Objs", 0));
+	pComp->Value(mkNamingAdapt(mkArrayAdaptMapS(pObjNrs, iObjCnt, mkIntPackAdapt<int32_t>), "Objs", 0));
 
 	C4ControlPacket::CompileFunc(pComp);
 }
@@ -429,11 +437,11 @@ void C4ControlPlayerCommand::CompileFunc(StdCompiler *pComp)
 {
 	pComp->Value(mkNamingAdapt(mkIntPackAdapt(iPlr),     "Player",  -1));
 	pComp->Value(mkNamingAdapt(mkIntPackAdapt(iCmd),     "Cmd",      0));
-	pComp->Value(mkNamingAdapt(iX,                       "X",        0));
-	pComp->Value(mkNamingAdapt(iY,                       "Y",        0));
-	pComp->Value(mkNamingAdapt(iTarget,                  "Target",   0));
-	pComp->Value(mkNamingAdapt(iTarget2,                 "Target2",  0));
-	pComp->Value(mkNamingAdapt(iData,                    "Data",     0));
+	pComp->Value(mkNamingAdapt(mkIntPackAdapt(iX),       "X",        0));
+	pComp->Value(mkNamingAdapt(mkIntPackAdapt(iY),       "Y",        0));
+	pComp->Value(mkNamingAdapt(mkIntPackAdapt(iTarget),  "Target",   0));
+	pComp->Value(mkNamingAdapt(mkIntPackAdapt(iTarget2), "Target2",  0));
+	pComp->Value(mkNamingAdapt(mkIntPackAdapt(iData),    "Data",     0));
 	pComp->Value(mkNamingAdapt(mkIntPackAdapt(iAddMode), "AddMode",  0));
 	C4ControlPacket::CompileFunc(pComp);
 }
@@ -527,7 +535,7 @@ void C4ControlSyncCheck::CompileFunc(StdCompiler *pComp)
 	pComp->Value(mkNamingAdapt(RandomCount,                            "RandomCount",             0));
 	pComp->Value(mkNamingAdapt(mkIntPackAdapt(AllCrewPosX),            "AllCrewPosX",             0));
 	pComp->Value(mkNamingAdapt(mkIntPackAdapt(PXSCount),               "PXSCount",                0));
-	pComp->Value(mkNamingAdapt(MassMoverIndex,                         "MassMoverIndex",          0));
+	pComp->Value(mkNamingAdapt(mkIntPackAdapt(MassMoverIndex),         "MassMoverIndex",          0));
 	pComp->Value(mkNamingAdapt(mkIntPackAdapt(ObjectCount),            "ObjectCount",             0));
 	pComp->Value(mkNamingAdapt(mkIntPackAdapt(ObjectEnumerationIndex), "ObjectEnumerationIndex",  0));
 	pComp->Value(mkNamingAdapt(mkIntPackAdapt(SectShapeSum),           "SectShapeSum",            0));
@@ -972,9 +980,9 @@ void C4ControlEMMoveObject::Execute(const std::shared_ptr<spdlog::logger> &logge
 void C4ControlEMMoveObject::CompileFunc(StdCompiler *pComp)
 {
 	pComp->Value(mkNamingAdapt(mkIntAdaptT<uint8_t>(eAction),      "Action"));
-	pComp->Value(mkNamingAdapt(tx,                                 "tx",         0));
-	pComp->Value(mkNamingAdapt(ty,                                 "ty",         0));
-	pComp->Value(mkNamingAdapt(iTargetObj,                         "TargetObj", -1));
+	pComp->Value(mkNamingAdapt(mkIntPackAdapt(tx),                 "tx",         0));
+	pComp->Value(mkNamingAdapt(mkIntPackAdapt(ty),                 "ty",         0));
+	pComp->Value(mkNamingAdapt(mkIntPackAdapt(iTargetObj),         "TargetObj", -1));
 	pComp->Value(mkNamingAdapt(mkIntPackAdapt(iObjectNum),         "ObjectNum",  0));
 	pComp->Value(mkNamingAdapt(Strict,                             "Strict",     C4AulScriptStrict::MAXSTRICT));
 
@@ -1057,10 +1065,10 @@ void C4ControlEMDrawTool::CompileFunc(StdCompiler *pComp)
 {
 	pComp->Value(mkNamingAdapt(mkIntAdaptT<uint8_t>(eAction), "Action"));
 	pComp->Value(mkNamingAdapt(mkIntPackAdapt(iMode),         "Mode",     0));
-	pComp->Value(mkNamingAdapt(iX,                            "X",        0));
-	pComp->Value(mkNamingAdapt(iY,                            "Y",        0));
-	pComp->Value(mkNamingAdapt(iX2,                           "X2",       0));
-	pComp->Value(mkNamingAdapt(iY2,                           "Y2",       0));
+	pComp->Value(mkNamingAdapt(mkIntPackAdapt(iX),            "X",        0));
+	pComp->Value(mkNamingAdapt(mkIntPackAdapt(iY),            "Y",        0));
+	pComp->Value(mkNamingAdapt(mkIntPackAdapt(iX2),           "X2",       0));
+	pComp->Value(mkNamingAdapt(mkIntPackAdapt(iY2),           "Y2",       0));
 	pComp->Value(mkNamingAdapt(mkIntPackAdapt(iGrade),        "Grade",    0));
 	pComp->Value(mkNamingAdapt(fIFT,                          "IFT",      false));
 	pComp->Value(mkNamingAdapt(Material,                      "Material", ""));
@@ -1447,7 +1455,7 @@ void C4ControlVote::CompileFunc(StdCompiler *pComp)
 {
 	pComp->Value(mkNamingAdapt(mkIntAdaptT<uint8_t>(eType), "Type",    VT_None));
 	pComp->Value(mkNamingAdapt(fApprove,                    "Approve", true));
-	pComp->Value(mkNamingAdapt(iData,                       "Data",    0));
+	pComp->Value(mkNamingAdapt(mkIntPackAdapt(iData),       "Data",    0));
 	C4ControlPacket::CompileFunc(pComp);
 }
 
@@ -25,8 +25,33 @@
 #include <C4Game.h>
 #include <C4Wrappers.h>
 
+#include <cstring>
 #include <format>
+#include <functional>
 #include <numbers>
+#include <string_view>
+#include <unordered_set>
+
+namespace
+{
+	struct EffectNameHash
+	{
+		using is_transparent = void;
+		std::size_t operator()(std::string_view name) const noexcept { return std::hash<std::string_view>{}(name); }
+	};
+
+	// all effect names used in this game; only cleared with the game, so interned pointers stay valid
+	std::unordered_set<std::string, EffectNameHash, std::equal_to<>> &EffectNames()
+	{
+		static std::unordered_set<std::string, EffectNameHash, std::equal_to<>> names;
+		return names;
+	}
+
+	bool IsWildcardMask(const char *szMask)
+	{
+		return std::strpbrk(szMask, "*?");
+	}
+}
 
 void C4Effect::AssignCallbackFunctions()
 {
@@ -62,10 +87,15 @@ C4Effect::C4Effect(C4Object *pForObj, const char *szName, int32_t iPrio, int32_t
 	C4Effect *pPrev, *pCheck;
 	// assign values
 	SCopy(szName, Name, C4MaxDefString);
+	NameKey = InternName(Name);
 	iPriority = 0; // effect is not yet valid; some callbacks to other effects are done before
 	riStoredAsNumber = 0;
 	iIntervall = iTimerIntervall;
-	iTime = 0;
+	pListState = &GetListState(pForObj);
+	pListState->AddName(NameKey);
+	iTimeBase = pListState->Ticks;
+	// the new effect needs to be scheduled (or deleted if it doesn't get valid)
+	pListState->Wake();
 	pCommandTarget = pCmdTarget;
 	pCommandTarget.Enumerate();
 	idCommandTarget = idCmdTarget;
@@ -146,6 +176,7 @@ C4Effect::C4Effect(C4Object *pForObj, const char *szName, int32_t iPrio, int32_t
 			pPrev->pNext = pNext;
 		}
 		pNext = nullptr;
+		pListState->RemoveName(NameKey);
 		throw;
 	}
 }
@@ -153,14 +184,17 @@ C4Effect::C4Effect(C4Object *pForObj, const char *szName, int32_t iPrio, int32_t
 C4Effect::C4Effect(StdCompiler *pComp) : EffectVars(0)
 {
 	// defaults
-	iNumber = iPriority = iTime = iIntervall = 0;
+	iNumber = iPriority = iTimeBase = iIntervall = 0;
 	pNext = nullptr;
+	NameKey = nullptr;
+	pListState = nullptr;
 	// compile
 	pComp->Value(*this);
 }
 
 C4Effect::~C4Effect()
 {
+	if (pListState) pListState->RemoveName(NameKey);
 	// del following effects (not recursively)
 	C4Effect *pEffect;
 	while (pEffect = pNext)
@@ -183,12 +217,20 @@ void C4Effect::EnumeratePointers()
 	} while (pEff = pEff->pNext);
 }
 
-void C4Effect::DenumeratePointers()
+void C4Effect::DenumeratePointers(C4Object *pObj)
 {
 	// denum in all effects
 	C4Effect *pEff = this;
 	do
 	{
+		// freshly loaded: attach to list schedule, keeping the loaded effect time
+		if (!pEff->pListState)
+		{
+			const int32_t iTime{pEff->GetTime()};
+			pEff->pListState = &GetListState(pObj);
+			pEff->pListState->AddName(pEff->NameKey);
+			pEff->SetTime(iTime);
+		}
 		// command target
 		pEff->pCommandTarget.Denumerate();
 		// variable pointers
@@ -216,6 +258,19 @@ C4Effect *C4Effect::Get(const char *szName, int32_t iIndex, int32_t iMaxPriority
 {
 	// safety
 	if (!szName) return nullptr;
+	// plain name: compare interned names
+	if (!IsWildcardMask(szName))
+	{
+		const C4EffectName name{FindName(szName)};
+		if (!name || (pListState && !pListState->HasName(name))) return nullptr;
+		C4Effect *pEff = this;
+		do
+			if (pEff->NameKey == name && !pEff->IsDead() && (!iMaxPriority || pEff->iPriority <= iMaxPriority))
+				if (!iIndex--)
+					return pEff;
+		while (pEff = pEff->pNext);
+		return nullptr;
+	}
 	// check all effects
 	C4Effect *pEff = this;
 	do
@@ -259,6 +314,17 @@ int32_t C4Effect::GetCount(const char *szMask, int32_t iMaxPriority)
 {
 	// count all matching effects
 	int32_t iCnt = 0; C4Effect *pEff = this;
+	// plain name: compare interned names
+	if (szMask && !IsWildcardMask(szMask))
+	{
+		const C4EffectName name{FindName(szMask)};
+		if (!name || (pListState && !pListState->HasName(name))) return 0;
+		do if (pEff->NameKey == name && !pEff->IsDead())
+			if (!iMaxPriority || pEff->iPriority <= iMaxPriority)
+				++iCnt;
+		while (pEff = pEff->pNext);
+		return iCnt;
+	}
 	do if (!pEff->IsDead())
 		if (!szMask || SWildcardMatchEx(pEff->Name, szMask))
 			if (!iMaxPriority || pEff->iPriority <= iMaxPriority)
@@ -316,10 +382,57 @@ int32_t C4Effect::Check(C4Object *pForObj, const char *szCheckEffect, int32_t iP
 	return 0;
 }
 
+C4EffectListState &C4Effect::GetListState(C4Object *pObj)
+{
+	return pObj ? pObj->EffectListState : Game.GlobalEffectListState;
+}
+
+C4EffectName C4Effect::InternName(const char *szName)
+{
+	return &*EffectNames().emplace(szName).first;
+}
+
+C4EffectName C4Effect::FindName(const char *szName)
+{
+	const auto &names = EffectNames();
+	const auto it = names.find(std::string_view{szName});
+	return it != names.end() ? &*it : nullptr;
+}
+
+void C4Effect::ClearNames()
+{
+	EffectNames().clear();
+}
+
+void C4Effect::SetName(const char *szName, std::size_t iMaxLength)
+{
+	SCopy(szName, Name, iMaxLength);
+	const C4EffectName newKey{InternName(Name)};
+	if (pListState)
+	{
+		pListState->RemoveName(NameKey);
+		pListState->AddName(newKey);
+	}
+	NameKey = newKey;
+}
+
+void C4Effect::SetTime(int32_t iTime)
+{
+	iTimeBase = (pListState ? pListState->Ticks : 0) - iTime;
+	if (pListState) pListState->Wake();
+}
+
 void C4Effect::Execute(C4Object *pObj)
 {
 	// get effect list
 	C4Effect **ppEffectList = pObj ? &pObj->pEffects : &Game.pGlobalEffects;
+	// time elapsed for all effects
+	C4EffectListState &State = GetListState(pObj);
+	++State.Ticks;
+	// no timer due and no dead effects: nothing else to do
+	if (State.Ticks < State.NextDue) return;
+	// effects changed during execution lower this again
+	State.NextDue = C4EffectListState::Idle;
 	// execute all effects not marked as dead
 	C4Effect *pEffect = this, **ppPrevEffect = ppEffectList;
 	do
@@ -336,13 +449,14 @@ void C4Effect::Execute(C4Object *pObj)
 		}
 		else
 		{
-			// execute effect: time elapsed
-			++pEffect->iTime;
+			// effects added or reset during this execution have their time elapsed in it, too
+			if (pEffect->iTimeBase == State.Ticks) --pEffect->iTimeBase;
+			const int32_t iTime{pEffect->GetTime()};
 			// check timer execution
-			if (pEffect->iIntervall && !(pEffect->iTime % pEffect->iIntervall))
+			if (pEffect->iIntervall && !(iTime % pEffect->iIntervall))
 				if (pEffect->pFnTimer)
 				{
-					if (pEffect->pFnTimer->Exec(pEffect->pCommandTarget, {C4VObj(pObj), C4VInt(pEffect->iNumber), C4VInt(pEffect->iTime)}, false, true).getInt() == C4Fx_Execute_Kill)
+					if (pEffect->pFnTimer->Exec(pEffect->pCommandTarget, {C4VObj(pObj), C4VInt(pEffect->iNumber), C4VInt(iTime)}, false, true).getInt() == C4Fx_Execute_Kill)
 					{
 						// safety: this class got deleted!
 						if (pObj && !pObj->Status) return;
@@ -355,6 +469,13 @@ void C4Effect::Execute(C4Object *pObj)
 				else
 					// no timer function: mark dead after time elapsed
 					pEffect->Kill(pObj);
+			// schedule next timer execution
+			if (pEffect->iIntervall)
+			{
+				const int32_t iIntervall{Abs(pEffect->iIntervall)};
+				const int32_t iNextTime{pEffect->GetTime()};
+				State.NextDue = std::min(State.NextDue, State.Ticks + iIntervall - (iNextTime % iIntervall + iIntervall) % iIntervall);
+			}
 			// next effect
 			ppPrevEffect = &pEffect->pNext;
 			pEffect = pEffect->pNext;
@@ -513,13 +634,16 @@ void C4Effect::CompileFunc(StdCompiler *pComp)
 {
 	// read name
 	pComp->Value(mkStringAdaptMI(Name));
+	if (pComp->isCompiler()) NameKey = InternName(Name);
 	pComp->Separator(StdCompiler::SEP_START); // '('
 	// read number
 	pComp->Value(iNumber); pComp->Separator();
 	// read priority
 	pComp->Value(iPriority); pComp->Separator();
 	// read time and intervall
+	int32_t iTime{GetTime()};
 	pComp->Value(iTime); pComp->Separator();
+	if (pComp->isCompiler()) SetTime(iTime);
 	pComp->Value(iIntervall); pComp->Separator();
 	// read object number
 	pComp->Value(pCommandTarget); pComp->Separator();
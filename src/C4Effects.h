@@ -28,6 +28,11 @@
 #include "C4EnumeratedObjectPtr.h"
 #include "C4ValueList.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
 typedef unsigned long C4ID;
 
 // callback return values
@@ -73,6 +78,33 @@ typedef unsigned long C4ID;
 #define C4Fx_FireMode_Object    3 // other (C4D_Object and no bit set (magic))
 #define C4Fx_FireMode_Last      3 // largest valid fire mode
 
+// interned effect name; effects with equal names share the same pointer
+using C4EffectName = const std::string *;
+
+// bookkeeping of an effect list (object effects or global effects)
+// effect times are counted in executions of their list; instead of advancing every effect each frame,
+// effects store the tick at which their time was zero, and the list is only walked when a timer is due or an effect died
+class C4EffectListState
+{
+public:
+	static constexpr int32_t Idle = INT32_MAX;
+
+	int32_t Ticks{0}; // number of executions of the effect list
+	int32_t NextDue{0}; // tick at which the list has to be walked next
+	std::unordered_map<C4EffectName, int32_t> NameCounts; // number of effects in the list by name, including dead ones
+
+	void Wake() { NextDue = std::min(NextDue, Ticks + 1); } // walk the list on its next execution
+
+	void AddName(C4EffectName name) { ++NameCounts[name]; }
+	void RemoveName(C4EffectName name)
+	{
+		const auto it = NameCounts.find(name);
+		if (it != NameCounts.end() && !--it->second) NameCounts.erase(it);
+	}
+
+	bool HasName(C4EffectName name) const { return NameCounts.contains(name); }
+};
+
 // generic object effect
 class C4Effect : private C4DeletionTrackable
 {
@@ -83,12 +115,16 @@ public:
 
 	int32_t iPriority; // effect priority for sorting into effect list; -1 indicates a dead effect
 	C4ValueList EffectVars; // custom effect variables
-	int32_t iTime, iIntervall; // effect time; effect callback intervall
+	int32_t iIntervall; // effect callback intervall
 	int32_t iNumber; // effect number for addressing
 
 	C4Effect *pNext; // next effect in linked list
 
 protected:
+	C4EffectName NameKey; // interned Name
+	C4EffectListState *pListState; // state of the list this effect is in; nullptr until denumerated after loading
+	int32_t iTimeBase; // schedule tick at which the effect time was zero
+
 	// presearched callback functions for faster calling
 	C4AulFunc *pFnTimer;           // timer function Fx%sTimer
 	C4AulFunc *pFnStart, *pFnStop; // init/deinit-functions Fx%sStart, Fx%sStop
@@ -103,16 +139,20 @@ public:
 	~C4Effect(); // dtor - deletes all following effects
 
 	void EnumeratePointers(); // object pointers to numbers
-	void DenumeratePointers(); // numbers to object pointers
+	void DenumeratePointers(C4Object *pObj); // numbers to object pointers
 	void ClearPointers(C4Object *pObj); // clear all pointers to object - may kill some effects w/o callback, because the callback target is lost
 
-	void SetDead()              { iPriority = 0; }        // mark effect to be removed in next execution cycle
+	void SetDead()              { iPriority = 0; if (pListState) pListState->Wake(); } // mark effect to be removed in next execution cycle
 	bool IsDead()               { return !iPriority; }    // return whether effect is to be removed
 	void FlipActive()           { iPriority *= -1; }      // alters activation status
 	bool IsActive()             { return iPriority > 0; } // returns whether effect is active
 	bool IsInactiveAndNotDead() { return iPriority < 0; } // as the name says
 
-	C4Effect *Get(const char *szName, int32_t iIndex = 0, int32_t iMaxPriority = 0); // get effect by name
+	int32_t GetTime() const { return (pListState ? pListState->Ticks : 0) - iTimeBase; } // effect time
+	void SetTime(int32_t iTime); // set effect time and reschedule timer
+	void SetName(const char *szName, std::size_t iMaxLength = C4MaxDefString); // rename effect; callback functions are not reassigned
+
+	C4Effect *Get(const char *szName, int32_t iIndex = 0, int32_t iMaxPriority = 0); // get effect by name or wildcard mask
 	C4Effect *Get(int32_t iNumber, bool fIncludeDead, int32_t iMaxPriority = 0); // get effect by number
 	int32_t GetCount(const char *szMask, int32_t iMaxPriority = 0); // count effects that match the mask
 	int32_t Check(C4Object *pForObj, const char *szCheckEffect, int32_t iPrio, int32_t iTimer, const C4Value &rVal1 = C4VNull, const C4Value &rVal2 = C4VNull, const C4Value &rVal3 = C4VNull, const C4Value &rVal4 = C4VNull, bool passErrors = false); // do some effect callbacks
@@ -140,7 +180,13 @@ public:
 
 	void CompileFunc(StdCompiler *pComp);
 
+	static void ClearNames(); // forget all interned names; only allowed when no effects exist anymore
+
 protected:
+	static C4EffectListState &GetListState(C4Object *pObj); // state of the object's effect list, or of the global effects
+	static C4EffectName InternName(const char *szName);
+	static C4EffectName FindName(const char *szName); // nullptr if no effect was ever named like this
+
 	void TempRemoveUpperEffects(C4Object *pObj, bool fTempRemoveThis, C4Effect **ppLastRemovedEffect); // temp remove all effects with higher priority
 	void TempReaddUpperEffects(C4Object *pObj, C4Effect *pLastReaddEffect); // temp remove all effects with higher priority
 };
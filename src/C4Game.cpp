@@ -595,6 +595,9 @@ void C4Game::Clear()
 	Landscape.Clear();
 	PXS.Clear();
 	delete pGlobalEffects; pGlobalEffects = nullptr;
+	GlobalEffectListState = {};
+	// all object and global effects are gone now
+	C4Effect::ClearNames();
 	Particles.Clear();
 	Material.Clear();
 	TextureMap.Clear(); // texture map *MUST* be cleared after the materials, because of the patterns!
@@ -1799,6 +1802,7 @@ void C4Game::Default()
 	pScenarioSections = pCurrentScenarioSection = nullptr;
 	*CurrentScenarioSection = 0;
 	pGlobalEffects = nullptr;
+	GlobalEffectListState = {};
 	fResortAnyObject = false;
 	pNetworkStatistics = nullptr;
 	IsMusicEnabled = false;
@@ -2049,7 +2053,7 @@ bool C4Game::SaveData(C4Group &hGroup, bool fSaveSection, bool fInitial, bool fS
 	{
 		ScriptEngine.DenumerateVariablePointers();
 		Players.DenumeratePointers();
-		if (pGlobalEffects) pGlobalEffects->DenumeratePointers();
+		if (pGlobalEffects) pGlobalEffects->DenumeratePointers(nullptr);
 	}
 
 	// Initial?
@@ -2467,7 +2471,7 @@ bool C4Game::InitGame(C4Group &hGroup, C4ScenarioSection *section, bool fLoadSky
 
 	// Denumerate game data pointers
 	if (!section) ScriptEngine.DenumerateVariablePointers();
-	if (!section && pGlobalEffects) pGlobalEffects->DenumeratePointers();
+	if (!section && pGlobalEffects) pGlobalEffects->DenumeratePointers(nullptr);
 
 	// Check object enumeration
 	if (!CheckObjectEnumeration())
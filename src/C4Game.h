@@ -129,6 +129,7 @@ public:
 	C4GUI::Screen *pGUI;
 	C4ScenarioSection *pScenarioSections, *pCurrentScenarioSection;
 	C4Effect *pGlobalEffects;
+	C4EffectListState GlobalEffectListState;
 #ifndef USE_CONSOLE
 	// We don't need fonts when we don't have graphics
 	C4FontLoader FontLoader;
@@ -361,6 +362,8 @@ protected:
 	CStdCSecEx PreloadMutex;
 	bool LandscapeLoaded;
 	std::unique_ptr<C4FileMonitor> FileMonitor;
+
+	friend class C4ScriptBenchmark;
 };
 
 const int32_t C4RULE_StructuresNeedEnergy      = 1,
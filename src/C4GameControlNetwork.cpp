@@ -30,6 +30,7 @@ C4GameControlNetwork::C4GameControlNetwork(C4GameControl *pnParent)
 	: fEnabled(false), fRunning(false), iClientID(C4ClientIDUnknown),
 	fActivated(false), iTargetTick(-1),
 	iControlPreSend(1), iWaitStart(-1), iAvgControlSendTime(0), iTargetFPS(DefaultTargetFPS),
+	iControlRateBase(-1), iAutoControlRate(-1), iControlRateCheckTime(0), iControlRateTicks(0), iControlRateStalls(0),
 	iControlSent(0), iControlReady(0),
 	pCtrlStack(nullptr),
 	iNextControlReqeust(0),
@@ -59,6 +60,7 @@ bool C4GameControlNetwork::Init(int32_t inClientID, bool fnHost, int32_t iStartT
 	// ok
 	fEnabled = true; fRunning = false;
 	iTargetFPS = DefaultTargetFPS; iNextControlReqeust = timeGetTime() + C4ControlRequestInterval;
+	iAutoControlRate = -1; iControlRateCheckTime = timeGetTime(); iControlRateTicks = iControlRateStalls = 0;
 	return true;
 }
 
@@ -365,18 +367,27 @@ void C4GameControlNetwork::SetCtrlMode(C4GameControlNetworkMode enMode) // by ma
 	// set mode
 	eMode = enMode;
 	// changed to decentral? rebroadcast all own control
+	// changed to central on host? rebroadcast all complete control
+	int32_t iRebroadcastID;
 	if (enMode == CNM_Decentral)
-	{
-		CStdLock CtrlLock(&CtrlCSec); C4GameControlPacket *pPkt;
-		for (int32_t iCtrlTick = Game.Control.ControlTick; pPkt = getCtrl(iClientID, iCtrlTick); iCtrlTick++)
-			Game.Network.Clients.BroadcastMsgToClients(MkC4NetIOPacket(PID_Control, *pPkt));
-	}
+		iRebroadcastID = iClientID;
 	else if (enMode == CNM_Central && fHost)
+		iRebroadcastID = C4ClientIDAll;
+	else
+		return;
+	CStdLock CtrlLock(&CtrlCSec); C4GameControlPacket *pPkt;
+	C4PacketControlBatch Batch;
+	for (int32_t iCtrlTick = Game.Control.ControlTick; pPkt = getCtrl(iRebroadcastID, iCtrlTick); iCtrlTick++)
 	{
-		CStdLock CtrlLock(&CtrlCSec); C4GameControlPacket *pPkt;
-		for (int32_t iCtrlTick = Game.Control.ControlTick; pPkt = getCtrl(C4ClientIDAll, iCtrlTick); iCtrlTick++)
-			Game.Network.Clients.BroadcastMsgToClients(MkC4NetIOPacket(PID_Control, *pPkt));
+		Batch.Add(*pPkt);
+		if (Batch.isFull())
+		{
+			Game.Network.Clients.BroadcastMsgToClients(MkC4NetIOPacket(PID_ControlBatch, Batch));
+			Batch.Clear();
+		}
 	}
+	if (!Batch.isEmpty())
+		Game.Network.Clients.BroadcastMsgToClients(MkC4NetIOPacket(PID_ControlBatch, Batch));
 }
 
 void C4GameControlNetwork::CalcPerformance(int32_t iCtrlTick)
@@ -386,7 +397,7 @@ void C4GameControlNetwork::CalcPerformance(int32_t iCtrlTick)
 	// should only be called if ready
 	assert(CtrlReady(iCtrlTick));
 	// calc perfomance for all clients
-	int32_t iClientsPing = 0; int32_t iPingClientCount = 0; int32_t iNumTunnels = 0; int32_t iHostPing = 0;
+	int32_t iClientsPing = 0; int32_t iNumTunnels = 0; int32_t iHostPing = 0;
 	for (C4GameControlClient *pClient = pClients; pClient; pClient = pClient->pNext)
 	{
 		// Some rudimentary PreSend-calculation
@@ -398,15 +409,12 @@ void C4GameControlNetwork::CalcPerformance(int32_t iCtrlTick)
 			if (!pConn)
 				// remember tunnel
 				++iNumTunnels;
-			else
-				// store ping
+			else if (const int iPing = pConn->getPingEstimate(); iPing >= 0)
+				// store ping (including jitter, so control is rarely late)
 				if (pClient->getClientID() == C4ClientIDHost)
-					iHostPing = pConn->getPingTime();
+					iHostPing = iPing;
 				else
-				{
-					iClientsPing += pConn->getPingTime();
-					++iPingClientCount;
-				}
+					iClientsPing = (std::max)(iClientsPing, iPing);
 		}
 		// Performance statistics
 		// find control (may not be found, if we only got the complete ctrl)
@@ -419,8 +427,8 @@ void C4GameControlNetwork::CalcPerformance(int32_t iCtrlTick)
 	int32_t iControlSendTime;
 	if (eMode == CNM_Decentral)
 	{
-		// average ping time
-		iControlSendTime = (iClientsPing + iHostPing * (iNumTunnels + 1)) / (iPingClientCount + iNumTunnels + 1);
+		// the slowest connection decides when control is complete
+		iControlSendTime = (std::max)(iClientsPing, iHostPing);
 		// decentral mode: Only half the ping is used if there are no tunnels
 		if (!iNumTunnels) iControlSendTime /= 2;
 	}
@@ -429,12 +437,14 @@ void C4GameControlNetwork::CalcPerformance(int32_t iCtrlTick)
 		// central mode: Control must go to host and back
 		iControlSendTime = iHostPing;
 	}
-	// calc some average
+	// calc some average: follow rising send times at once to avoid stalls, but lower PreSend only slowly
+	int32_t iNeededPreSend = 1;
 	if (iControlSendTime)
 	{
-		iAvgControlSendTime = (iAvgControlSendTime * 149 + iControlSendTime * 1000) / 150;
+		iAvgControlSendTime = (std::max)((iAvgControlSendTime * 149 + iControlSendTime * 1000) / 150, iControlSendTime * 1000);
 		// now calculate the all-time optimum PreSend there is
-		int32_t iBestPreSend = BoundBy((iTargetFPS * iAvgControlSendTime) / 1000000 + 1, 1, 15);
+		iNeededPreSend = (iTargetFPS * iAvgControlSendTime) / 1000000 + 1;
+		int32_t iBestPreSend = BoundBy(iNeededPreSend, 1, C4MaxPreSend);
 		// fixed PreSend?
 		if (iTargetFPS <= 0) iBestPreSend = -iTargetFPS;
 		// Ha! Set it!
@@ -444,6 +454,37 @@ void C4GameControlNetwork::CalcPerformance(int32_t iCtrlTick)
 			Game.GraphicsSystem.FlashMessage(std::format("PreSend: {}  - TargetFPS: {}", iBestPreSend, iTargetFPS).c_str());
 		}
 	}
+	// control host: pick a control rate which gets along with the latency
+	if (fHost && Config.Network.AutoControlRate)
+		UpdateControlRate(iNeededPreSend, iWaitStart != -1 && static_cast<int32_t>(timeGetTime()) - iWaitStart > C4ControlStallTime);
+}
+
+void C4GameControlNetwork::UpdateControlRate(int32_t iNeededPreSend, bool fStalled)
+{
+	++iControlRateTicks;
+	if (fStalled) ++iControlRateStalls;
+	// evaluate whole periods, so a change has time to take effect
+	const uint32_t iTime = timeGetTime();
+	if (iTime < iControlRateCheckTime + C4AutoControlRateInterval) return;
+	// changed by somebody else? take it as the new minimum
+	if (Game.Control.ControlRate != iAutoControlRate)
+		iControlRateBase = iAutoControlRate = Game.Control.ControlRate;
+	// PreSend can't hide the latency, or the control is late too often: fewer control ticks mean fewer stalls
+	int32_t iNewRate = iAutoControlRate;
+	if (iNeededPreSend > C4MaxPreSend || iControlRateStalls * 10 > iControlRateTicks)
+		iNewRate = (std::min)(iAutoControlRate + 1, C4MaxControlRate);
+	// connection has recovered: go back towards the chosen rate for lower input latency
+	else if (!iControlRateStalls && iNeededPreSend <= C4MaxPreSend / 2)
+		iNewRate = (std::max)(iAutoControlRate - 1, iControlRateBase);
+	if (iNewRate != iAutoControlRate)
+	{
+		pParent->GetLogger()->info("Control rate {} -> {} (PreSend needed: {}, stalls: {}/{})", iAutoControlRate, iNewRate, iNeededPreSend, iControlRateStalls, iControlRateTicks);
+		Game.Control.DoInput(CID_Set, new C4ControlSet(C4CVT_AutoControlRate, iNewRate), CDT_Decide);
+		iAutoControlRate = iNewRate;
+	}
+	// start next period
+	iControlRateCheckTime = iTime;
+	iControlRateTicks = iControlRateStalls = 0;
 }
 
 void C4GameControlNetwork::HandlePacket(char cStatus, const C4PacketBase *pPacket, C4Network2IOConnection *pConn)
@@ -465,6 +506,14 @@ void C4GameControlNetwork::HandlePacket(char cStatus, const C4PacketBase *pPacke
 	}
 	break;
 
+	case PID_ControlBatch: // several control packets
+	{
+		GETPKT(C4PacketControlBatch, rPkt);
+		for (uint32_t i = 0; i < rPkt.getCount(); i++)
+			HandleControl(pConn->getClientID(), rPkt.getCtrl(i));
+	}
+	break;
+
 	case PID_ControlReq: // control request
 	{
 		if (!IsEnabled()) break;
@@ -531,14 +580,20 @@ void C4GameControlNetwork::HandleControl(int32_t iByClientID, const C4GameContro
 void C4GameControlNetwork::HandleControlReq(const C4PacketControlReq &rPkt, C4Network2IOConnection *pConn)
 {
 	CStdLock CtrlLock(&CtrlCSec);
+	// collect the requested ticks, so the client can catch up with few messages
+	C4PacketControlBatch Batch;
 	for (int iTick = rPkt.getCtrlTick(); ; iTick++)
 	{
+		if (Batch.isFull())
+		{
+			pConn->Send(MkC4NetIOPacket(PID_ControlBatch, Batch));
+			Batch.Clear();
+		}
 		// search complete control
 		C4GameControlPacket *pCtrl = getCtrl(C4ClientIDAll, iTick);
 		if (pCtrl)
 		{
-			// send
-			pConn->Send(MkC4NetIOPacket(PID_Control, *pCtrl));
+			Batch.Add(*pCtrl);
 			continue;
 		}
 		// send everything we have for this tick (this is an emergency case, so efficiency
@@ -547,12 +602,15 @@ void C4GameControlNetwork::HandleControlReq(const C4PacketControlReq &rPkt, C4Ne
 		for (pCtrl = pCtrlStack; pCtrl; pCtrl = pCtrl->pNext)
 			if (pCtrl->getCtrlTick() == iTick)
 			{
-				pConn->Send(MkC4NetIOPacket(PID_Control, *pCtrl));
+				Batch.Add(*pCtrl);
 				fFound = true;
 			}
 		// nothing found for this tick?
 		if (!fFound) break;
 	}
+	// send
+	if (!Batch.isEmpty())
+		pConn->Send(MkC4NetIOPacket(PID_ControlBatch, Batch));
 }
 
 void C4GameControlNetwork::HandleControlPkt(C4PacketType eCtrlType, C4ControlPacket *pCtrl, C4ControlDeliveryType eType) // main thread
@@ -684,6 +742,8 @@ void C4GameControlNetwork::CheckCompleteCtrl(bool fSetEvent) // by both
 	CStdLock CtrlLock(&CtrlCSec);
 	CStdLock ClientLock(&ClientsCSec);
 
+	// complete control packed in one go (e.g. after a lag) is sent as one message
+	C4PacketControlBatch Packed;
 	for (;;)
 	{
 		// control available?
@@ -705,7 +765,7 @@ void C4GameControlNetwork::CheckCompleteCtrl(bool fSetEvent) // by both
 			// central mode and not host?
 			if (eMode != CNM_Decentral && !fHost) break;
 			// (try to) pack
-			if (!(pComplete = PackCompleteCtrl(iControlReady + 1)))
+			if (!(pComplete = PackCompleteCtrl(iControlReady + 1, Packed)))
 				break;
 		}
 		// preexecute to check if it's ready for execute
@@ -717,6 +777,7 @@ void C4GameControlNetwork::CheckCompleteCtrl(bool fSetEvent) // by both
 		if (fSetEvent && Game.GameGo && iControlReady >= Game.Control.ControlTick)
 			Application.NextTick(true);
 	}
+	BroadcastCompleteCtrl(Packed);
 	// clear old ctrl
 	if (Game.Control.ControlTick >= C4ControlBacklog)
 		ClearCtrl(Game.Control.ControlTick - C4ControlBacklog);
@@ -738,7 +799,7 @@ void C4GameControlNetwork::CheckCompleteCtrl(bool fSetEvent) // by both
 	}
 }
 
-C4GameControlPacket *C4GameControlNetwork::PackCompleteCtrl(int32_t iTick)
+C4GameControlPacket *C4GameControlNetwork::PackCompleteCtrl(int32_t iTick, C4PacketControlBatch &Send)
 {
 	CStdLock CtrlLock(&CtrlCSec);
 	CStdLock ClientLock(&ClientsCSec);
@@ -774,7 +835,11 @@ C4GameControlPacket *C4GameControlNetwork::PackCompleteCtrl(int32_t iTick)
 
 	// host: send to clients (central and async mode)
 	if (eMode != CNM_Decentral)
-		Game.Network.Clients.BroadcastMsgToConnClients(MkC4NetIOPacket(PID_Control, *pComplete));
+	{
+		if (Send.isFull())
+			BroadcastCompleteCtrl(Send);
+		Send.Add(*pComplete);
+	}
 
 	// advance control request time
 	iNextControlReqeust = std::max<uint32_t>(iNextControlReqeust, timeGetTime() + C4ControlRequestInterval);
@@ -783,6 +848,16 @@ C4GameControlPacket *C4GameControlNetwork::PackCompleteCtrl(int32_t iTick)
 	return pComplete;
 }
 
+void C4GameControlNetwork::BroadcastCompleteCtrl(C4PacketControlBatch &Send)
+{
+	// a single tick goes out as plain control
+	if (Send.getCount() == 1)
+		Game.Network.Clients.BroadcastMsgToConnClients(MkC4NetIOPacket(PID_Control, Send.getCtrl(0)));
+	else if (!Send.isEmpty())
+		Game.Network.Clients.BroadcastMsgToConnClients(MkC4NetIOPacket(PID_ControlBatch, Send));
+	Send.Clear();
+}
+
 void C4GameControlNetwork::AddSyncCtrlToQueue(const C4Control &Ctrl, int32_t iTick) // by main thread
 {
 	// search place in queue. It's vitally important that new packets are placed
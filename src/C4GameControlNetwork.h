@@ -21,6 +21,8 @@
 #include "C4Network2.h"
 
 #include <atomic>
+#include <memory>
+#include <vector>
 
 // constants
 const int32_t C4ControlBacklog = 100, // (ctrl ticks)
@@ -28,7 +30,10 @@ const int32_t C4ControlBacklog = 100, // (ctrl ticks)
               C4ControlOverflowLimit = 3, // (ctrl ticks)
               C4MaxPreSend = 15; // (frames) - must be smaller than C4ControlBacklog!
 
-const uint32_t C4ControlRequestInterval = 2000; // (ms)
+const uint32_t C4ControlRequestInterval = 2000, // (ms)
+               C4AutoControlRateInterval = 10000; // (ms) - period over which the automatic control rate is evaluated
+
+const int32_t C4ControlStallTime = 30; // (ms) - waiting longer than about a frame for control counts as a stall
 
 enum C4ControlDeliveryType
 {
@@ -55,7 +60,7 @@ enum C4GameControlNetworkMode
 
 // declarations
 class C4GameControlPacket; class C4GameControlClient;
-class C4PacketControlReq; class C4ClientList;
+class C4PacketControlReq; class C4PacketControlBatch; class C4ClientList;
 
 // main class
 class C4GameControlNetwork // run by network thread
@@ -83,6 +88,12 @@ protected:
 	int32_t iAvgControlSendTime;
 	int32_t iTargetFPS; // used for PreSend-colculation
 
+	// automatic control rate (host only)
+	int32_t iControlRateBase; // control rate chosen by the user; the lower bound
+	int32_t iAutoControlRate; // control rate last set automatically
+	uint32_t iControlRateCheckTime; // start of the current evaluation period
+	int32_t iControlRateTicks, iControlRateStalls; // control ticks in this period, and how many of them were waited for
+
 	// control send / recv status
 	std::atomic<std::int32_t> iControlSent, iControlReady;
 
@@ -148,6 +159,7 @@ public:
 
 	// performance
 	void CalcPerformance(int32_t iCtrlTick); // by main thread
+	void UpdateControlRate(int32_t iNeededPreSend, bool fStalled); // by main thread
 
 	// interfaces
 	void HandlePacket(char cStatus, const C4PacketBase *pPacket, C4Network2IOConnection *pConn);
@@ -173,7 +185,8 @@ protected:
 	void AddCtrl(C4GameControlPacket *pCtrl);
 	void ClearCtrl(int32_t iBeforeTick = -1);
 	void CheckCompleteCtrl(bool fSetEvent); // by both
-	C4GameControlPacket *PackCompleteCtrl(int32_t iTick); // by main thread
+	C4GameControlPacket *PackCompleteCtrl(int32_t iTick, C4PacketControlBatch &Send); // by main thread
+	void BroadcastCompleteCtrl(C4PacketControlBatch &Send);
 
 	// sync control
 	void AddSyncCtrlToQueue(const C4Control &Ctrl, int32_t iTick); // by main thread
@@ -183,6 +196,7 @@ protected:
 class C4GameControlPacket : public C4PacketBase
 {
 	friend class C4GameControlNetwork;
+	friend class C4PacketControlBatch;
 
 public:
 	C4GameControlPacket();
@@ -263,6 +277,27 @@ public:
 	virtual void CompileFunc(StdCompiler *pComp) override;
 };
 
+// several control packets in one message; client ID and control tick are stored relative to the previous entry
+class C4PacketControlBatch : public C4PacketBase
+{
+public:
+	static constexpr uint32_t MaxCount = C4ControlBacklog;
+
+protected:
+	std::vector<std::unique_ptr<C4GameControlPacket>> Ctrls;
+
+public:
+	uint32_t getCount() const { return static_cast<uint32_t>(Ctrls.size()); }
+	const C4GameControlPacket &getCtrl(uint32_t i) const { return *Ctrls[i]; }
+	bool isEmpty() const { return Ctrls.empty(); }
+	bool isFull() const { return Ctrls.size() >= MaxCount; }
+
+	void Add(const C4GameControlPacket &Ctrl);
+	void Clear() { Ctrls.clear(); }
+
+	virtual void CompileFunc(StdCompiler *pComp) override;
+};
+
 class C4PacketControlPkt : public C4PacketBase
 {
 public:
@@ -292,5 +327,5 @@ protected:
 public:
 	int32_t getControlTick() const { return iControlTick; }
 
-	virtual void CompileFunc(StdCompiler *pComp) override { pComp->Value(mkNamingAdapt(iControlTick, "ControlTick", -1)); }
+	virtual void CompileFunc(StdCompiler *pComp) override { pComp->Value(mkNamingAdapt(mkIntPackAdapt(iControlTick), "ControlTick", -1)); }
 };
@@ -128,8 +128,8 @@ void C4GameObjects::CrossCheck() // Every Tick1 by ExecObjects
 							if (Game.Players.Hostile(obj1->Owner, obj2->Owner))
 							{
 								// RejectFight callback
-								if (obj1->Call(PSF_RejectFight, {C4VObj(obj2)}).getBool()) continue;
-								if (obj2->Call(PSF_RejectFight, {C4VObj(obj1)}).getBool()) continue;
+								if (obj1->Call(C4DefScriptHost::CB_RejectFight, {C4VObj(obj2)}).getBool()) continue;
+								if (obj2->Call(C4DefScriptHost::CB_RejectFight, {C4VObj(obj1)}).getBool()) continue;
 								ObjectActionFight(obj1, obj2);
 								ObjectActionFight(obj2, obj1);
 								continue;
@@ -165,7 +165,7 @@ void C4GameObjects::CrossCheck() // Every Tick1 by ExecObjects
 										obj2->Marker = Marker;
 										// Hit
 										if ((obj2->OCF & OCF_HitSpeed2) && (obj1->OCF & OCF_Alive) && (obj2->Category & C4D_Object))
-											if (!obj1->Call(PSF_QueryCatchBlow, {C4VObj(obj2)}))
+											if (!obj1->Call(C4DefScriptHost::CB_QueryCatchBlow, {C4VObj(obj2)}))
 											{
 												// "realistic" hit energy
 												C4Fixed dXDir = obj2->xdir - obj1->xdir, dYDir = obj2->ydir - obj1->ydir;
@@ -175,7 +175,7 @@ void C4GameObjects::CrossCheck() // Every Tick1 by ExecObjects
 												int tmass = std::max<int32_t>(obj1->Mass, 50);
 												if (!Tick3 || (obj1->Action.Act >= 0 && obj1->Def->ActMap[obj1->Action.Act].Procedure != DFA_FLIGHT))
 													obj1->Fling(obj2->xdir * 50 / tmass, -Abs(obj2->ydir / 2) * 50 / tmass, false, obj2->Controller);
-												obj1->Call(PSF_CatchBlow, {C4VInt(-iHitEnergy / 5),
+												obj1->Call(C4DefScriptHost::CB_CatchBlow, {C4VInt(-iHitEnergy / 5),
 													C4VObj(obj2)});
 												// obj1 might have been tampered with
 												if (!obj1->Status || obj1->Contained || !(obj1->OCF & focf))
@@ -578,6 +578,8 @@ void C4GameSaveRecord::AdjustCore(C4Scenario &rC4S)
 	// specific recording flags
 	rC4S.Head.Replay = true;
 	rC4S.Head.Icon = 29;
+	// mark build, so engines that can't read the control format refuse the record
+	rC4S.Head.C4XVer[4] = C4XVERBUILD;
 	// default record title
 	std::array<char, C4MaxTitle + 1> buf;
 	FormatWithNull(buf, "{:03} {} [{}]", iNum, Game.Parameters.ScenarioTitle.getData(), C4XVERBUILD);
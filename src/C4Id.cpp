@@ -21,7 +21,7 @@
 
 #include <format>
 
-static char C4IdTextBuffer[5];
+static thread_local char C4IdTextBuffer[5];
 
 const char *C4IdText(C4ID id)
 {
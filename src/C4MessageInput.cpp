@@ -22,6 +22,8 @@
 #include <C4Include.h>
 #include <C4MessageInput.h>
 
+#include <C4AulStackProfiler.h>
+
 #include <C4Game.h>
 #include <C4Object.h>
 #include <C4Script.h>
@@ -453,6 +455,7 @@ bool C4MessageInput::ProcessCommand(const char *szCommand)
 		LogNTr("/fast [x] - {}", LoadResStr(C4ResStrTableKey::IDS_TEXT_SETTOFASTMODESKIPPINGXFRA));
 		LogNTr("/slow - {}", LoadResStr(C4ResStrTableKey::IDS_TEXT_SETTONORMALSPEEDMODE));
 		LogNTr("/chart - {}", LoadResStr(C4ResStrTableKey::IDS_TEXT_DISPLAYNETWORKSTATISTICS));
+		LogNTr("/profile start [n] | stop [file] - {}", LoadResStr(C4ResStrTableKey::IDS_TEXT_STARTORSTOPTHESCRIPTCALLS));
 		LogNTr("/nodebug - {}", LoadResStr(C4ResStrTableKey::IDS_TEXT_PREVENTDEBUGMODEINTHISROU));
 		LogNTr("/set comment [comment] - {}", LoadResStr(C4ResStrTableKey::IDS_TEXT_SETANEWNETWORKCOMMENT));
 		LogNTr("/set password [password] - {}", LoadResStr(C4ResStrTableKey::IDS_TEXT_SETANEWNETWORKPASSWORD));
@@ -609,6 +612,24 @@ bool C4MessageInput::ProcessCommand(const char *szCommand)
 		return true;
 	}
 
+	// script call stack profiler; only measures locally, so it doesn't need to go through control
+	if (SEqual(szCmdName, "profile"))
+	{
+		if (!Game.IsRunning) return false;
+		if (SEqual2(pCmdPar, "start"))
+		{
+			C4AulStackProfiler::Start(std::max(atoi(pCmdPar + 5), 1));
+			return true;
+		}
+		if (SEqual2(pCmdPar, "stop"))
+		{
+			const char *const filename{SAdvanceSpace(pCmdPar + 4)};
+			C4AulStackProfiler::Stop(*filename ? filename : nullptr);
+			return true;
+		}
+		return false;
+	}
+
 	if (SEqual(szCmdName, "nodebug"))
 	{
 		if (!Game.IsRunning) return false;
@@ -113,6 +113,13 @@ bool C4Object::Contact(int32_t iCNAT)
 {
 	if (Def->ContactFunctionCalls)
 	{
+		switch (iCNAT)
+		{
+		case CNAT_Left:   return static_cast<bool>(Call(C4DefScriptHost::CB_ContactLeft));
+		case CNAT_Right:  return static_cast<bool>(Call(C4DefScriptHost::CB_ContactRight));
+		case CNAT_Top:    return static_cast<bool>(Call(C4DefScriptHost::CB_ContactTop));
+		case CNAT_Bottom: return static_cast<bool>(Call(C4DefScriptHost::CB_ContactBottom));
+		}
 		return static_cast<bool>(Call(std::format(PSF_Contact, CNATName(iCNAT)).c_str()));
 	}
 	return false;
@@ -472,9 +479,9 @@ void C4Object::DoMovement()
 	if (fAnyContact)
 	{
 		C4AulParSet pars(C4VInt(fixtoi(oldxdir, 100)), C4VInt(fixtoi(oldydir, 100)));
-		if (old_ocf & OCF_HitSpeed1) Call(PSF_Hit,  pars);
-		if (old_ocf & OCF_HitSpeed2) Call(PSF_Hit2, pars);
-		if (old_ocf & OCF_HitSpeed3) Call(PSF_Hit3, pars);
+		if (old_ocf & OCF_HitSpeed1) Call(C4DefScriptHost::CB_Hit,  pars);
+		if (old_ocf & OCF_HitSpeed2) Call(C4DefScriptHost::CB_Hit2, pars);
+		if (old_ocf & OCF_HitSpeed3) Call(C4DefScriptHost::CB_Hit3, pars);
 	}
 
 	// Rotation gfx
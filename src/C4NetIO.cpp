@@ -22,6 +22,7 @@
 #include "C4Network2Address.h"
 #include "Standard.h"
 
+#include <array>
 #include <assert.h>
 #include <errno.h>
 #include <fcntl.h>
@@ -419,6 +420,14 @@ bool C4NetIO::InitIPv6Socket(const SOCKET socket)
 	return true;
 }
 
+void C4NetIO::CloseSocket(const SOCKET socket)
+{
+	closesocket(socket);
+#ifndef _WIN32
+	OnFDClosed(socket);
+#endif
+}
+
 void C4NetIO::SetError(const char *strnError, bool fSockErr)
 {
 	fSockErr &= HaveSocketError();
@@ -535,7 +544,7 @@ bool C4NetIOTCP::Close()
 	// close listen socket
 	if (lsock != INVALID_SOCKET)
 	{
-		closesocket(lsock);
+		CloseSocket(lsock);
 		lsock = INVALID_SOCKET;
 	}
 
@@ -553,6 +562,7 @@ bool C4NetIOTCP::Close()
 	// close pipe
 	close(Pipe[0]);
 	close(Pipe[1]);
+	OnFDClosed(Pipe[0]);
 #endif
 
 	// ok
@@ -672,13 +682,13 @@ bool C4NetIOTCP::Execute(int iMaxTime) // (mt-safe)
 				int iErrCode; socklen_t iErrCodeLen = sizeof(iErrCode);
 				if (getsockopt(sock, SOL_SOCKET, SO_ERROR, reinterpret_cast<char *>(&iErrCode), &iErrCodeLen) != 0)
 				{
-					close(sock);
+					CloseSocket(sock);
 					if (pCB) pCB->OnDisconn(pWait->addr, this, GetSocketErrorMsg());
 				}
 				// error?
 				else if (iErrCode)
 				{
-					close(sock);
+					CloseSocket(sock);
 					if (pCB) pCB->OnDisconn(pWait->addr, this, GetSocketErrorMsg(iErrCode));
 				}
 				else
@@ -902,7 +912,7 @@ bool C4NetIOTCP::Close(const addr_t &addr) // (mt-safe)
 	if (pWait)
 	{
 		// close socket, do callback
-		closesocket(pWait->sock); pWait->sock = INVALID_SOCKET;
+		CloseSocket(pWait->sock); pWait->sock = INVALID_SOCKET;
 		if (pCB) pCB->OnDisconn(pWait->addr, this, "closed");
 	}
 	else
@@ -936,6 +946,17 @@ bool C4NetIOTCP::Send(const C4NetIOPacket &rPacket) // (mt-safe)
 	return pPeer->Send(rPacket);
 }
 
+bool C4NetIOTCP::SendBulk(const C4NetIOPacket &rPacket) // (mt-safe)
+{
+	CStdShareLock PeerListLock(&PeerListCSec);
+	// find peer
+	Peer *pPeer = GetPeer(rPacket.getAddr());
+	// not found?
+	if (!pPeer) return false;
+	// send
+	return pPeer->Send(rPacket, true);
+}
+
 bool C4NetIOTCP::SetBroadcast(const addr_t &addr, bool fSet) // (mt-safe)
 {
 	CStdShareLock PeerListLock(&PeerListCSec);
@@ -950,11 +971,20 @@ bool C4NetIOTCP::SetBroadcast(const addr_t &addr, bool fSet) // (mt-safe)
 bool C4NetIOTCP::Broadcast(const C4NetIOPacket &rPacket) // (mt-safe)
 {
 	CStdShareLock PeerListLock(&PeerListCSec);
-	// just send to all clients
+	// pack once, then queue the same data for all clients
+	std::shared_ptr<const StdBuf> packed;
 	bool fSuccess = true;
 	for (Peer *pPeer = pPeerList; pPeer; pPeer = pPeer->Next)
 		if (pPeer->Open() && pPeer->doBroadcast())
-			fSuccess &= Send(C4NetIOPacket(rPacket.getRef(), pPeer->GetAddr()));
+		{
+			if (!packed)
+			{
+				StdBuf buf;
+				PackPacket(rPacket, buf);
+				packed = std::make_shared<const StdBuf>(std::move(buf));
+			}
+			fSuccess &= pPeer->SendPacked(packed);
+		}
 	return fSuccess;
 }
 
@@ -1030,6 +1060,16 @@ bool C4NetIOTCP::GetConnStatistic(const addr_t &addr, int *pIRate, int *pORate,
 	return true;
 }
 
+bool C4NetIOTCP::GetConnQueueSize(const addr_t &addr, size_t *pQueued, size_t *pBulkQueued) // (mt-safe)
+{
+	CStdShareLock PeerListLock(&PeerListCSec);
+	// find peer
+	Peer *pPeer = GetPeer(addr);
+	if (!pPeer || !pPeer->Open()) return false;
+	pPeer->GetQueueSize(pQueued, pBulkQueued);
+	return true;
+}
+
 void C4NetIOTCP::ClearStatistic()
 {
 	CStdShareLock PeerListLock(&PeerListCSec);
@@ -1081,13 +1121,18 @@ C4NetIOTCP::Peer *C4NetIOTCP::Accept(SOCKET nsock, const addr_t &ConnectAddr) //
 	{
 		// set error
 		SetError("socket accept failed: invalid address returned");
-		closesocket(nsock);
+		CloseSocket(nsock);
 		return nullptr;
 	}
 
 	// disable nagle (yep, we know what we are doing here - I think)
 	int iNoDelay = 1;
 	::setsockopt(nsock, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char *>(&iNoDelay), sizeof(iNoDelay));
+#ifdef TCP_NOTSENT_LOWAT
+	// keep unsent data in our own queues, where packets may overtake bulk data
+	int iNotSentLowAt = 16 * 1024;
+	::setsockopt(nsock, IPPROTO_TCP, TCP_NOTSENT_LOWAT, reinterpret_cast<const char *>(&iNotSentLowAt), sizeof(iNotSentLowAt));
+#endif
 
 #ifdef _WIN32
 	// set event
@@ -1095,7 +1140,7 @@ C4NetIOTCP::Peer *C4NetIOTCP::Accept(SOCKET nsock, const addr_t &ConnectAddr) //
 	{
 		// set error
 		SetError("connection accept failed: could not set event", true);
-		closesocket(nsock);
+		CloseSocket(nsock);
 		return nullptr;
 	}
 #else
@@ -1104,7 +1149,7 @@ C4NetIOTCP::Peer *C4NetIOTCP::Accept(SOCKET nsock, const addr_t &ConnectAddr) //
 	{
 		// set error
 		SetError("connection accept failed: could not disable blocking", true);
-		close(nsock);
+		CloseSocket(nsock);
 		return nullptr;
 	}
 #endif
@@ -1138,7 +1183,7 @@ bool C4NetIOTCP::Listen(uint16_t inListenPort)
 	if (lsock != INVALID_SOCKET)
 	{
 		// close existing socket
-		closesocket(lsock);
+		CloseSocket(lsock);
 		lsock = INVALID_SOCKET;
 	}
 	iListenPort = addr_t::IPPORT_NONE;
@@ -1163,7 +1208,7 @@ bool C4NetIOTCP::Listen(uint16_t inListenPort)
 	if (::bind(lsock, &addr, addr.GetAddrLen()) == SOCKET_ERROR)
 	{
 		SetError("socket bind failed", true);
-		closesocket(lsock); lsock = INVALID_SOCKET;
+		CloseSocket(lsock); lsock = INVALID_SOCKET;
 		return false;
 	}
 
@@ -1172,7 +1217,7 @@ bool C4NetIOTCP::Listen(uint16_t inListenPort)
 	if (::WSAEventSelect(lsock, Event, FD_ACCEPT | FD_CLOSE) == SOCKET_ERROR)
 	{
 		SetError("could not set event for listen socket", true);
-		closesocket(lsock); lsock = INVALID_SOCKET;
+		CloseSocket(lsock); lsock = INVALID_SOCKET;
 		return false;
 	}
 #endif
@@ -1181,7 +1226,7 @@ bool C4NetIOTCP::Listen(uint16_t inListenPort)
 	if (::listen(lsock, SOMAXCONN) == SOCKET_ERROR)
 	{
 		SetError("socket listen failed", true);
-		closesocket(lsock); lsock = INVALID_SOCKET;
+		CloseSocket(lsock); lsock = INVALID_SOCKET;
 		return false;
 	}
 
@@ -1279,7 +1324,7 @@ void C4NetIOTCP::ClearConnectWaits() // (mt-safe)
 	for (ConnectWait *pWait = pConnectWaits; pWait; pWait = pWait->Next)
 		if (pWait->sock != INVALID_SOCKET)
 		{
-			closesocket(pWait->sock);
+			CloseSocket(pWait->sock);
 			pWait->sock = INVALID_SOCKET;
 		}
 }
@@ -1328,13 +1373,14 @@ size_t C4NetIOTCP::UnpackPacket(const StdBuf &IBuf, const C4NetIO::addr_t &addr)
 
 const unsigned int C4NetIOTCP::Peer::iTCPHeaderSize = 28 + 24; // (bytes)
 const unsigned int C4NetIOTCP::Peer::iMinIBufSize = 8192; // (bytes)
+const unsigned int C4NetIOTCP::Peer::iBulkFragmentSize = 16384; // (bytes)
 
 // construction / destruction
 
 C4NetIOTCP::Peer::Peer(const C4NetIO::addr_t &naddr, SOCKET nsock, C4NetIOTCP *pnParent)
 	: pParent(pnParent),
 	addr(naddr), sock(nsock),
-	Next(nullptr), iIBufUsage(0), iIRate(0), iORate(0),
+	Next(nullptr), iIBufUsage(0), OQueueOffset(0), OBulkOffset(0), iIRate(0), iORate(0),
 	fOpen(true), fDoBroadcast(false) {}
 
 C4NetIOTCP::Peer::~Peer()
@@ -1345,16 +1391,24 @@ C4NetIOTCP::Peer::~Peer()
 
 // implementation
 
-bool C4NetIOTCP::Peer::Send(const C4NetIOPacket &rPacket) // (mt-safe)
+bool C4NetIOTCP::Peer::Send(const C4NetIOPacket &rPacket, bool fBulk) // (mt-safe)
+{
+	// pack packet
+	StdBuf packed;
+	pParent->PackPacket(rPacket, packed);
+	return SendPacked(std::make_shared<const StdBuf>(std::move(packed)), fBulk);
+}
+
+bool C4NetIOTCP::Peer::SendPacked(std::shared_ptr<const StdBuf> packed, bool fBulk) // (mt-safe)
 {
 	CStdLock OLock(&OCSec);
 
-	// already data pending to be sent? try to sent them first (empty buffer)
-	if (!OBuf.isNull()) Send();
-	bool fSend = OBuf.isNull();
+	// already data pending to be sent? try to sent them first (empty queue)
+	if (hasWaitingData()) Send();
+	bool fSend = !hasWaitingData();
 
-	// pack packet
-	pParent->PackPacket(rPacket, OBuf);
+	// enqueue
+	(fBulk ? OBulkQueue : OQueue).push_back(std::move(packed));
 
 	// (try to) send
 	return fSend ? Send() : true;
@@ -1363,42 +1417,125 @@ bool C4NetIOTCP::Peer::Send(const C4NetIOPacket &rPacket) // (mt-safe)
 bool C4NetIOTCP::Peer::Send() // (mt-safe)
 {
 	CStdLock OLock(&OCSec);
-	if (OBuf.isNull()) return true;
+	for (;;)
+	{
+		// skip empty packets
+		while (!OQueue.empty() && OQueue.front()->getSize() <= OQueueOffset)
+		{
+			OQueue.pop_front();
+			OQueueOffset = 0;
+		}
+		// nothing else to send: bulk data may go next
+		if (OQueue.empty())
+		{
+			if (OBulkQueue.empty()) return true;
+			if (!pParent->fBulkFragments)
+			{
+				OQueue.push_back(std::move(OBulkQueue.front()));
+				OBulkQueue.pop_front();
+			}
+			else
+			{
+				// queue one fragment only, so packets sent meanwhile don't wait for the whole bulk packet
+				const StdBuf &bulk = *OBulkQueue.front();
+				const uint32_t iSize = static_cast<uint32_t>(std::min<size_t>(bulk.getSize() - OBulkOffset, iBulkFragmentSize));
+				StdBuf fragment;
+				fragment.New(sizeof(uint8_t) + sizeof(iSize) + iSize);
+				*fragment.getMPtr<uint8_t>(0) = 0xfe;
+				*fragment.getMPtr<uint32_t>(sizeof(uint8_t)) = iSize;
+				fragment.Write(bulk.getPtr(OBulkOffset), iSize, sizeof(uint8_t) + sizeof(iSize));
+				OQueue.push_back(std::make_shared<const StdBuf>(std::move(fragment)));
+				// bulk packet done?
+				if ((OBulkOffset += iSize) >= bulk.getSize())
+				{
+					OBulkQueue.pop_front();
+					OBulkOffset = 0;
+				}
+			}
+		}
 
-	// send as much as possibile
-	int iBytesSent;
-	if ((iBytesSent = ::send(sock, OBuf.getPtr<char>(), OBuf.getSize(), 0)) == SOCKET_ERROR)
-		if (!HaveWouldBlockError())
+		// gather as much of the queue as possible into one call
+		constexpr size_t MaxSegments = 64;
+#ifdef _WIN32
+		std::array<WSABUF, MaxSegments> segments;
+#else
+		std::array<iovec, MaxSegments> segments;
+#endif
+		size_t iSegmentCnt = 0, iOffset = OQueueOffset;
+		for (auto it = OQueue.begin(); it != OQueue.end() && iSegmentCnt < MaxSegments; ++it, iOffset = 0)
 		{
-			pParent->SetError("send failed", true);
-			return false;
+			const StdBuf &buf = **it;
+			if (iOffset >= buf.getSize()) continue;
+#ifdef _WIN32
+			segments[iSegmentCnt++] = {static_cast<ULONG>(buf.getSize() - iOffset), const_cast<char *>(buf.getPtr<char>(iOffset))};
+#else
+			segments[iSegmentCnt++] = {const_cast<char *>(buf.getPtr<char>(iOffset)), buf.getSize() - iOffset};
+#endif
 		}
 
-	// nothin sent?
-	if (iBytesSent == SOCKET_ERROR || !iBytesSent) return true;
+		// send as much as possibile
+		int iBytesSent;
+#ifdef _WIN32
+		DWORD iSent;
+		iBytesSent = ::WSASend(sock, segments.data(), static_cast<DWORD>(iSegmentCnt), &iSent, 0, nullptr, nullptr) == SOCKET_ERROR ? SOCKET_ERROR : static_cast<int>(iSent);
+#else
+		msghdr msg{};
+		msg.msg_iov = segments.data();
+		msg.msg_iovlen = iSegmentCnt;
+		iBytesSent = ::sendmsg(sock, &msg, 0);
+#endif
+		if (iBytesSent == SOCKET_ERROR)
+			if (!HaveWouldBlockError())
+			{
+				pParent->SetError("send failed", true);
+				return false;
+			}
 
-	// increase output rate
-	iORate += iBytesSent + iTCPHeaderSize;
+		// nothin sent?
+		if (iBytesSent == SOCKET_ERROR || !iBytesSent) break;
+
+		// increase output rate
+		iORate += iBytesSent + iTCPHeaderSize;
+
+		// drop everything that has been sent completely
+		size_t iRemaining = iBytesSent;
+		while (!OQueue.empty() && OQueue.front()->getSize() - OQueueOffset <= iRemaining)
+		{
+			iRemaining -= OQueue.front()->getSize() - OQueueOffset;
+			OQueue.pop_front();
+			OQueueOffset = 0;
+		}
+		OQueueOffset += iRemaining;
+		// keep going until the socket would block, so there will be another write notification
+	}
 
-	// data remaining?
-	if (unsigned(iBytesSent) < OBuf.getSize())
-	{
-		// Shrink buffer
-		OBuf.Move(iBytesSent, OBuf.getSize() - iBytesSent);
-		OBuf.Shrink(iBytesSent);
 #ifndef _WIN32
-		// Unblock parent so the FD-list can be refreshed
+	// data remaining? Unblock parent so the FD-list can be refreshed
+	if (hasWaitingData())
 		pParent->UnBlock();
 #endif
-	}
-	else
-		// just delete buffer
-		OBuf.Clear();
 
 	// ok
 	return true;
 }
 
+void C4NetIOTCP::Peer::GetQueueSize(size_t *pQueued, size_t *pBulkQueued) // (mt-safe)
+{
+	CStdLock OLock(&OCSec);
+	if (pQueued)
+	{
+		*pQueued = 0;
+		for (const auto &packed : OQueue) *pQueued += packed->getSize();
+		*pQueued -= std::min(*pQueued, OQueueOffset);
+	}
+	if (pBulkQueued)
+	{
+		*pBulkQueued = 0;
+		for (const auto &packed : OBulkQueue) *pBulkQueued += packed->getSize();
+		*pBulkQueued -= std::min(*pBulkQueued, OBulkOffset);
+	}
+}
+
 void *C4NetIOTCP::Peer::GetRecvBuf(int iSize) // (mt-safe)
 {
 	CStdLock ILock(&ICSec);
@@ -1426,7 +1563,7 @@ void C4NetIOTCP::Peer::OnRecv(int iSize) // (mt-safe)
 	{
 		// Try to unpack a packet
 		StdBuf IBufPart = IBuf.getPart(iPos, iIBufUsage - iPos);
-		int32_t iBytes = pParent->UnpackPacket(IBufPart, addr);
+		int32_t iBytes = pParent->fBulkFragments && *IBufPart.getPtr<uint8_t>() == 0xfe ? UnpackBulkFragment(IBufPart) : pParent->UnpackPacket(IBufPart, addr);
 		// Could not unpack?
 		if (!iBytes)
 			break;
@@ -1458,17 +1595,44 @@ void C4NetIOTCP::Peer::OnRecv(int iSize) // (mt-safe)
 	}
 }
 
+size_t C4NetIOTCP::Peer::UnpackBulkFragment(const StdBuf &rInBuf) // (mt-safe)
+{
+	// skip marker (0xfe), read fragment size
+	size_t iPos = sizeof(uint8_t);
+	if (iPos + sizeof(uint32_t) > rInBuf.getSize())
+		return 0;
+	const uint32_t iSize = *rInBuf.getPtr<uint32_t>(iPos);
+	iPos += sizeof(uint32_t);
+	// fragment incomplete?
+	if (iPos + iSize < iPos || iPos + iSize > rInBuf.getSize())
+		return 0;
+	// collect, then unpack all bulk packets completed by this fragment
+	BulkIBuf.Append(rInBuf.getPtr(iPos), iSize);
+	size_t iUsed = 0, iBytes;
+	while (iUsed < BulkIBuf.getSize() && (iBytes = pParent->UnpackPacket(BulkIBuf.getPart(iUsed, BulkIBuf.getSize() - iUsed), addr)))
+		iUsed += iBytes;
+	if (iUsed)
+	{
+		BulkIBuf.Move(iUsed, BulkIBuf.getSize() - iUsed);
+		BulkIBuf.Shrink(iUsed);
+	}
+	// absorbed
+	return iPos + iSize;
+}
+
 void C4NetIOTCP::Peer::Close() // (mt-safe)
 {
 	CStdLock ILock(&ICSec); CStdLock OLock(&OCSec);
 	if (!fOpen) return;
 	// close socket
-	closesocket(sock);
+	pParent->CloseSocket(sock);
 	sock = INVALID_SOCKET;
 	// set flag
 	fOpen = false;
 	// clear buffers
-	IBuf.Clear(); OBuf.Clear();
+	IBuf.Clear(); BulkIBuf.Clear();
+	OQueue.clear(); OQueueOffset = 0;
+	OBulkQueue.clear(); OBulkOffset = 0;
 	iIBufUsage = 0;
 	// reset statistics
 	iIRate = iORate = 0;
@@ -1653,7 +1817,7 @@ bool C4NetIOSimpleUDP::Close()
 	// close sockets
 	if (sock != INVALID_SOCKET)
 	{
-		closesocket(sock);
+		CloseSocket(sock);
 		sock = INVALID_SOCKET;
 	}
 
@@ -1671,6 +1835,7 @@ bool C4NetIOSimpleUDP::Close()
 	// close pipes
 	close(Pipe[0]);
 	close(Pipe[1]);
+	OnFDClosed(Pipe[0]);
 #endif
 
 	// ok
@@ -1728,6 +1893,14 @@ bool C4NetIOSimpleUDP::Execute(int iMaxTime)
 		// nothing?
 		if (!iMaxMsgSize)
 			break;
+#ifdef __linux__
+		// read as many datagrams as possible at once
+		if (const int iReceived{ReceiveBatch()}; iReceived < 0)
+			return false;
+		else if (iReceived > 0)
+			continue;
+		// otherwise let recvfrom handle (or report) the error
+#endif
 		// alloc buffer
 		C4NetIOPacket Pkt; Pkt.New(iMaxMsgSize);
 		// read data (note: it is _not_ garantueed that iMaxMsgSize bytes are available)
@@ -1770,6 +1943,55 @@ bool C4NetIOSimpleUDP::Execute(int iMaxTime)
 	return true;
 }
 
+#ifdef __linux__
+
+struct C4NetIOSimpleUDP::RecvBatch
+{
+	std::array<mmsghdr, RecvBatchSize> Headers;
+	std::array<iovec, RecvBatchSize> Vectors;
+	std::array<sockaddr_in6, RecvBatchSize> Addrs;
+	std::array<std::array<char, RecvSlotSize>, RecvBatchSize> Buffers;
+};
+
+int C4NetIOSimpleUDP::ReceiveBatch()
+{
+	if (!recvBatch) recvBatch = std::make_unique_for_overwrite<RecvBatch>();
+	RecvBatch &batch{*recvBatch};
+	for (std::size_t i{0}; i < RecvBatchSize; ++i)
+	{
+		batch.Vectors[i] = {batch.Buffers[i].data(), RecvSlotSize};
+		batch.Headers[i] = {};
+		batch.Headers[i].msg_hdr.msg_name = &batch.Addrs[i];
+		batch.Headers[i].msg_hdr.msg_namelen = sizeof(sockaddr_in6);
+		batch.Headers[i].msg_hdr.msg_iov = &batch.Vectors[i];
+		batch.Headers[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	const int iCount{::recvmmsg(sock, batch.Headers.data(), RecvBatchSize, MSG_DONTWAIT, nullptr)};
+	// errors (including ICMP notifications) are picked up by recvfrom
+	if (iCount <= 0) return 0;
+
+	for (int i{0}; i < iCount; ++i)
+	{
+		const mmsghdr &header{batch.Headers[i]};
+		addr_t SrcAddr; SrcAddr.SetAddress(reinterpret_cast<const sockaddr *>(&batch.Addrs[i]));
+		// invalid address?
+		if ((header.msg_hdr.msg_namelen != sizeof(sockaddr_in) && header.msg_hdr.msg_namelen != sizeof(sockaddr_in6)) || SrcAddr.GetFamily() == addr_t::UnknownFamily)
+		{
+			SetError("recvmmsg returned an invalid address");
+			return -1;
+		}
+		// empty? ignore
+		if (!header.msg_len || (header.msg_hdr.msg_flags & MSG_TRUNC))
+			continue;
+		// callback
+		if (pCB) pCB->OnPacket(C4NetIOPacket(batch.Buffers[i].data(), header.msg_len, false, SrcAddr), this);
+	}
+	return iCount;
+}
+
+#endif
+
 bool C4NetIOSimpleUDP::Send(const C4NetIOPacket &rPacket)
 {
 	if (!fInit) { SetError("not yet initialized"); return false; }
@@ -1790,6 +2012,57 @@ bool C4NetIOSimpleUDP::Send(const C4NetIOPacket &rPacket)
 	return true;
 }
 
+bool C4NetIOSimpleUDP::SendBatch(const std::span<const C4NetIOPacket> packets)
+{
+	if (!fInit) { SetError("not yet initialized"); return false; }
+
+#ifdef __linux__
+	constexpr std::size_t SendBatchSize{64};
+	std::array<mmsghdr, SendBatchSize> headers;
+	std::array<iovec, SendBatchSize> vectors;
+	std::array<addr_t, SendBatchSize> addrs;
+
+	bool fSuccess{true};
+	for (std::size_t iStart{0}; iStart < packets.size(); )
+	{
+		const std::size_t iCount{std::min(packets.size() - iStart, SendBatchSize)};
+		for (std::size_t i{0}; i < iCount; ++i)
+		{
+			const C4NetIOPacket &rPacket{packets[iStart + i]};
+			addrs[i] = rPacket.getAddr();
+			vectors[i] = {const_cast<char *>(rPacket.getPtr<char>()), rPacket.getSize()};
+			headers[i] = {};
+			headers[i].msg_hdr.msg_name = const_cast<sockaddr *>(static_cast<const sockaddr *>(&addrs[i]));
+			headers[i].msg_hdr.msg_namelen = addrs[i].GetAddrLen();
+			headers[i].msg_hdr.msg_iov = &vectors[i];
+			headers[i].msg_hdr.msg_iovlen = 1;
+		}
+
+		const int iSent{::sendmmsg(sock, headers.data(), iCount, 0)};
+		if (iSent < 0)
+		{
+			// the packet at iStart failed: drop it like sendto would
+			if (!HaveWouldBlockError())
+			{
+				SetError("socket sendmmsg failed", true);
+				fSuccess = false;
+			}
+			++iStart;
+		}
+		else
+			iStart += std::max(iSent, 1);
+	}
+
+	if (fSuccess) ResetError();
+	return fSuccess;
+#else
+	bool fSuccess{true};
+	for (const C4NetIOPacket &rPacket : packets)
+		fSuccess &= C4NetIOSimpleUDP::Send(rPacket);
+	return fSuccess;
+#endif
+}
+
 bool C4NetIOSimpleUDP::Broadcast(const C4NetIOPacket &rPacket)
 {
 	// just set broadcast address and send
@@ -2364,10 +2637,13 @@ bool C4NetIOUDP::Broadcast(const C4NetIOPacket &rPacket) // (mt-safe)
 		// send it
 		fSuccess &= BroadcastDirect(*pPkt);
 	}
-	// send to all clients connected via du, too
+	// send to all clients connected via du, too (in one batch)
+	std::vector<C4NetIOPacket> batch;
 	for (pPeer = pPeerList; pPeer; pPeer = pPeer->Next)
 		if (pPeer->Open() && !pPeer->MultiCast() && pPeer->doBroadcast())
-			pPeer->Send(rPacket);
+			pPeer->Send(rPacket, &batch);
+	if (!batch.empty())
+		SendDirect(std::move(batch));
 	return true;
 }
 
@@ -2786,7 +3062,7 @@ bool C4NetIOUDP::Peer::Connect(bool fFailCallback) // (mt-safe)
 	return DoConn(false);
 }
 
-bool C4NetIOUDP::Peer::Send(const C4NetIOPacket &rPacket) // (mt-safe)
+bool C4NetIOUDP::Peer::Send(const C4NetIOPacket &rPacket, std::vector<C4NetIOPacket> *const batch) // (mt-safe)
 {
 	CStdLock OutLock(&OutCSec);
 	// encapsulate packet
@@ -2800,6 +3076,12 @@ bool C4NetIOUDP::Peer::Send(const C4NetIOPacket &rPacket) // (mt-safe)
 	// It is not secure to send packets before the connection
 	// is etablished completly.
 	if (eStatus != CS_Works) return true;
+	// leave sending to the caller?
+	if (batch)
+	{
+		AddFragments(*pnPacket, *batch);
+		return true;
+	}
 	// send it
 	if (!SendDirect(*pnPacket))
 	{
@@ -3126,24 +3408,36 @@ bool C4NetIOUDP::Peer::SendDirect(const Packet &rPacket, unsigned int iNr)
 	// send one fragment only?
 	if (iNr + 1)
 		return SendDirect(rPacket.GetFragment(iNr - rPacket.GetNr()));
-	// otherwise: send all fragments
-	bool fSuccess = true;
-	for (unsigned int i = 0; i < rPacket.FragmentCnt(); i++)
-		fSuccess &= SendDirect(rPacket.GetFragment(i));
-	return fSuccess;
+	// otherwise: send all fragments at once
+	std::vector<C4NetIOPacket> batch;
+	AddFragments(rPacket, batch);
+	return pParent->SendDirect(std::move(batch));
 }
 
 bool C4NetIOUDP::Peer::SendDirect(C4NetIOPacket &&rPacket) // (mt-safe)
 {
-	// insert correct addr
-	const C4NetIO::addr_t v6Addr{addr.AsIPv6()};
-	if (!(rPacket.getStatus() & 0x80)) rPacket.SetAddr(v6Addr);
-	// count outgoing
-	{ CStdLock StatLock(&StatCSec); iORate += rPacket.getSize() + iUDPHeaderSize; }
+	PrepareDirect(rPacket);
 	// forward call
 	return pParent->SendDirect(std::move(rPacket));
 }
 
+void C4NetIOUDP::Peer::PrepareDirect(C4NetIOPacket &rPacket) // (mt-safe)
+{
+	// insert correct addr
+	if (!(rPacket.getStatus() & 0x80)) rPacket.SetAddr(addr.AsIPv6());
+	// count outgoing
+	CStdLock StatLock(&StatCSec); iORate += rPacket.getSize() + iUDPHeaderSize;
+}
+
+void C4NetIOUDP::Peer::AddFragments(const Packet &rPacket, std::vector<C4NetIOPacket> &batch)
+{
+	for (unsigned int i = 0; i < rPacket.FragmentCnt(); i++)
+	{
+		batch.push_back(rPacket.GetFragment(i));
+		PrepareDirect(batch.back());
+	}
+}
+
 void C4NetIOUDP::Peer::OnConn()
 {
 	// reset timeout
@@ -3252,20 +3546,34 @@ bool C4NetIOUDP::BroadcastDirect(const Packet &rPacket, unsigned int iNr) // (mt
 	if (iNr + 1)
 		return SendDirect(rPacket.GetFragment(iNr - rPacket.GetNr(), true));
 	// send all fragments
-	bool fSuccess = true;
+	std::vector<C4NetIOPacket> batch;
+	batch.reserve(rPacket.FragmentCnt());
 	for (unsigned int iFrgm = 0; iFrgm < rPacket.FragmentCnt(); iFrgm++)
-		fSuccess &= SendDirect(rPacket.GetFragment(iFrgm, true));
-	return fSuccess;
+		batch.push_back(rPacket.GetFragment(iFrgm, true));
+	return SendDirect(std::move(batch));
 }
 
 bool C4NetIOUDP::SendDirect(C4NetIOPacket &&rPacket) // (mt-safe)
 {
-	addr_t toaddr = rPacket.getAddr();
+	if (!PrepareDirect(rPacket)) return true;
+	// send it
+	return C4NetIOSimpleUDP::Send(rPacket);
+}
+
+bool C4NetIOUDP::SendDirect(std::vector<C4NetIOPacket> &&packets) // (mt-safe)
+{
+	std::erase_if(packets, [this](C4NetIOPacket &packet) { return !PrepareDirect(packet); });
+	// send them with one system call where possible
+	return C4NetIOSimpleUDP::SendBatch(packets);
+}
+
+bool C4NetIOUDP::PrepareDirect(C4NetIOPacket &rPacket) // (mt-safe)
+{
 	// packet meant to be broadcasted?
 	if (rPacket.getStatus() & 0x80)
 	{
 		// set addr
-		toaddr = C4NetIOSimpleUDP::getMCAddr();
+		rPacket.SetAddr(C4NetIOSimpleUDP::getMCAddr());
 		// statistics
 		CStdLock StatLock(&StatCSec);
 		iBroadcastRate += rPacket.getSize() + iUDPHeaderSize;
@@ -3273,16 +3581,15 @@ bool C4NetIOUDP::SendDirect(C4NetIOPacket &&rPacket) // (mt-safe)
 
 	// debug
 #ifdef C4NETIO_DEBUG
-	{ C4NetIOPacket Pkt2 = rPacket; Pkt2.SetAddr(toaddr); DebugLogPkt(true, Pkt2); }
+	DebugLogPkt(true, rPacket);
 #endif
 
 #ifdef C4NETIO_SIMULATE_PACKETLOSS
 	if ((rPacket.getStatus() & 0x7F) != IPID_Test)
-		if (SafeRandom(100) < C4NETIO_SIMULATE_PACKETLOSS) return true;
+		if (SafeRandom(100) < C4NETIO_SIMULATE_PACKETLOSS) return false;
 #endif
 
-	// send it
-	return C4NetIOSimpleUDP::Send(C4NetIOPacket(rPacket.getRef(), toaddr));
+	return true;
 }
 
 bool C4NetIOUDP::DoLoopbackTest()
@@ -26,7 +26,9 @@
 #include "StdCompiler.h"
 #include "StdScheduler.h"
 
+#include <deque>
 #include <memory>
+#include <span>
 #include <vector>
 
 
@@ -99,17 +101,21 @@ public:
 	virtual bool Close(const addr_t &addr) = 0;
 
 	virtual bool Send(const class C4NetIOPacket &rPacket) = 0;
+	virtual bool SendBulk(const class C4NetIOPacket &rPacket) { return Send(rPacket); } // may be overtaken by packets sent later
 	virtual bool SetBroadcast(const addr_t &addr, bool fSet = true) = 0;
 	virtual bool Broadcast(const class C4NetIOPacket &rPacket) = 0;
 
 	// statistics
 	virtual bool GetStatistic(int *pBroadcastRate) = 0;
 	virtual bool GetConnStatistic(const addr_t &addr, int *pIRate, int *pORate, int *pLoss) = 0;
+	virtual bool GetConnQueueSize(const addr_t &addr, size_t *pQueued, size_t *pBulkQueued) { return false; } // (bytes) not sent yet
 	virtual void ClearStatistic() = 0;
 
 protected:
 	// Makes IPv4 connections from an IPv6 socket work.
 	bool InitIPv6Socket(SOCKET socket);
+	// Closes a socket which may be in the FD set of the scheduler.
+	void CloseSocket(SOCKET socket);
 
 	// *** errors
 protected:
@@ -196,9 +202,14 @@ public:
 	virtual bool Close(const addr_t &addr) override;
 
 	virtual bool Send(const C4NetIOPacket &rPacket) override;
+	virtual bool SendBulk(const C4NetIOPacket &rPacket) override;
 	virtual bool Broadcast(const C4NetIOPacket &rPacket) override;
 	virtual bool SetBroadcast(const addr_t &addr, bool fSet = true) override;
 
+	// send bulk packets in fragments, so other packets only have to wait for one fragment
+	// (set before Init; both sides must use it, as it changes the stream format)
+	void SetBulkFragments(bool fSet) { fBulkFragments = fSet; }
+
 	virtual void UnBlock();
 #ifdef _WIN32
 	virtual HANDLE GetEvent() override;
@@ -209,6 +220,7 @@ public:
 	// statistics
 	virtual bool GetStatistic(int *pBroadcastRate) override;
 	virtual bool GetConnStatistic(const addr_t &addr, int *pIRate, int *pORate, int *pLoss) override;
+	virtual bool GetConnQueueSize(const addr_t &addr, size_t *pQueued, size_t *pBulkQueued) override;
 	virtual void ClearStatistic() override;
 
 protected:
@@ -234,15 +246,25 @@ protected:
 		// constants
 		static const unsigned int iTCPHeaderSize; // = 28 + 24; // (bytes)
 		static const unsigned int iMinIBufSize; // = 8192; // (bytes)
+		static const unsigned int iBulkFragmentSize; // = 16384; // (bytes)
 		// parent
 		C4NetIOTCP *const pParent;
 		// addr
 		C4NetIO::addr_t addr;
 		// socket connected
 		SOCKET sock;
-		// incoming & outgoing buffer
-		StdBuf IBuf, OBuf;
+		// incoming buffer
+		StdBuf IBuf;
 		int iIBufUsage;
+		// outgoing queue of packed packets (shared between peers on broadcast); the first one is sent from OQueueOffset
+		std::deque<std::shared_ptr<const StdBuf>> OQueue;
+		size_t OQueueOffset;
+		// bulk data, only moved to the outgoing queue once it is empty (fragment by fragment
+		// if the parent sends fragments; the first one is fragmented from OBulkOffset)
+		std::deque<std::shared_ptr<const StdBuf>> OBulkQueue;
+		size_t OBulkOffset;
+		// received bulk fragments, until the packet is complete
+		StdBuf BulkIBuf;
 		// statistics
 		int iIRate, iORate;
 		// status (1 = open, 0 = closed)
@@ -258,14 +280,18 @@ protected:
 		SOCKET                 GetSocket() const { return sock; }
 		int                    GetIRate()  const { return iIRate; }
 		int                    GetORate()  const { return iORate; }
-		// send a packet to this peer
-		bool Send(const C4NetIOPacket &rPacket);
-		// send as much data of the interal outgoing buffer as possible
+		// send a packet to this peer (bulk: queue behind everything sent later)
+		bool Send(const C4NetIOPacket &rPacket, bool fBulk = false);
+		// send a packet that was already packed by the parent
+		bool SendPacked(std::shared_ptr<const StdBuf> packed, bool fBulk = false);
+		// send as much data of the interal outgoing queue as possible
 		bool Send();
 		// request buffer space for new input. Must call OnRecv or NoRecv afterwards!
 		void *GetRecvBuf(int iSize);
 		// called after the buffer returned by GetRecvBuf has been filled with fresh data
 		void OnRecv(int iSize);
+		// collect a bulk fragment from the start of the input buffer; returns the number of bytes used
+		size_t UnpackBulkFragment(const StdBuf &rInBuf);
 		// close socket
 		void Close();
 		// test: open?
@@ -273,7 +299,8 @@ protected:
 		// selected for broadcast?
 		bool doBroadcast() const { return fDoBroadcast; }
 		// outgoing data waiting?
-		bool hasWaitingData() const { return !OBuf.isNull(); }
+		bool hasWaitingData() const { return !OQueue.empty() || !OBulkQueue.empty(); }
+		void GetQueueSize(size_t *pQueued, size_t *pBulkQueued);
 		// select/unselect peer
 		void SetBroadcast(bool fSet) { fDoBroadcast = fSet; }
 		// statistics
@@ -305,6 +332,9 @@ protected:
 	// initialized?
 	bool fInit;
 
+	// fragment bulk packets?
+	bool fBulkFragments{false};
+
 	// listen socket
 	uint16_t iListenPort;
 	SOCKET lsock{INVALID_SOCKET};
@@ -360,6 +390,8 @@ public:
 
 	virtual bool Send(const C4NetIOPacket &rPacket) override;
 	virtual bool Broadcast(const C4NetIOPacket &rPacket) override;
+	// sends all packets with as few system calls as possible (sendmmsg on Linux)
+	bool SendBatch(std::span<const C4NetIOPacket> packets);
 
 	virtual void UnBlock();
 #ifdef _WIN32
@@ -420,6 +452,15 @@ private:
 	enum WaitResult { WR_Timeout, WR_Readable, WR_Cancelled, WR_Error = -1, };
 	WaitResult WaitForSocket(int iTimeout);
 
+#ifdef __linux__
+	// batched receiving with recvmmsg
+	static constexpr std::size_t RecvBatchSize = 16;
+	static constexpr std::size_t RecvSlotSize = 65536; // any datagram fits; pages are only touched when used
+	struct RecvBatch;
+	std::unique_ptr<RecvBatch> recvBatch; // allocated on first use
+	int ReceiveBatch(); // returns the number of datagrams read, 0 to fall back to recvfrom or -1 on error
+#endif
+
 	// *** callbacks
 public:
 	virtual void SetCallback(CBClass *pnCallback) override { pCB = pnCallback; }
@@ -453,6 +494,7 @@ public:
 
 	virtual bool Send(const C4NetIOPacket &rPacket) override;
 	bool SendDirect(C4NetIOPacket &&packet); // (mt-safe)
+	bool SendDirect(std::vector<C4NetIOPacket> &&packets); // (mt-safe)
 	virtual bool Broadcast(const C4NetIOPacket &rPacket) override;
 	virtual bool SetBroadcast(const addr_t &addr, bool fSet = true) override;
 
@@ -637,8 +679,8 @@ protected:
 		// initiate connection
 		bool Connect(bool fFailCallback);
 
-		// send something to this computer
-		bool Send(const C4NetIOPacket &rPacket);
+		// send something to this computer (batch: append fragments instead of sending them)
+		bool Send(const C4NetIOPacket &rPacket, std::vector<C4NetIOPacket> *batch = nullptr);
 		// check for lost packets
 		bool Check(bool fForceCheck = true);
 
@@ -682,6 +724,8 @@ protected:
 		// sending
 		bool SendDirect(const Packet &rPacket, unsigned int iNr = ~0);
 		bool SendDirect(C4NetIOPacket &&rPacket);
+		void PrepareDirect(C4NetIOPacket &rPacket);
+		void AddFragments(const Packet &rPacket, std::vector<C4NetIOPacket> &batch);
 
 		// events
 		void OnConn();
@@ -740,6 +784,7 @@ protected:
 
 	// sending
 	bool BroadcastDirect(const Packet &rPacket, unsigned int iNr = ~0u); // (mt-safe)
+	bool PrepareDirect(C4NetIOPacket &rPacket); // returns false if the packet should be dropped
 
 	// multicast related
 	bool DoLoopbackTest();
@@ -34,6 +34,8 @@
 
 #include <cassert>
 #include <concepts>
+#include <cstdlib>
+#include <vector>
 
 // internal structures
 struct C4Network2IO::NetEvPacketData
@@ -57,7 +59,8 @@ C4Network2IO::C4Network2IO()
 	pAutoAcceptList(nullptr),
 	iLastPing(0), iLastExecute(0), iLastStatistic(0),
 	iTCPIRate(0), iTCPORate(0), iTCPBCRate(0),
-	iUDPIRate(0), iUDPORate(0), iUDPBCRate(0)
+	iUDPIRate(0), iUDPORate(0), iUDPBCRate(0),
+	iSendQueueSize(0), iBulkQueueSize(0)
 {
 }
 
@@ -114,7 +117,10 @@ bool C4Network2IO::Init(const std::uint16_t iPortTCP, const std::uint16_t iPortU
 	}
 
 	// initialize net i/o classes: TCP first
-	pNetIO_TCP = CreateNetIO(logger, "TCP I/O", new C4NetIOTCP{}, iPortTCP, Thread);
+	// (resource chunks are sent in fragments, so control only waits for one fragment)
+	auto *const pTCP = new C4NetIOTCP{};
+	pTCP->SetBulkFragments(true);
+	pNetIO_TCP = CreateNetIO(logger, "TCP I/O", pTCP, iPortTCP, Thread);
 	if (pNetIO_TCP)
 	{
 		pNetIO_TCP->SetCallback(this);
@@ -393,12 +399,30 @@ void C4Network2IO::EndBroadcast()
 
 bool C4Network2IO::Broadcast(const C4NetIOPacket &rPkt)
 {
+	// copy the data once; all packet logs share it
+	const auto pPkt = std::make_shared<const C4NetIOPacket>(rPkt.Duplicate());
 	bool fSuccess = true;
-	// There is no broadcasting atm, emulate it
 	CStdLock ConnListLock(&ConnListCSec);
+	// keep the packet logs locked until the packet is sent, so no other packet
+	// can get between log and wire (post mortem relies on the order)
+	const bool fLogged = C4Network2IOConnection::isLoggedPacket(pPkt->getStatus());
+	std::vector<C4Network2IOConnection *> LockedConns;
 	for (C4Network2IOConnection *pConn = pConnList; pConn; pConn = pConn->pNext)
 		if (pConn->isOpen() && pConn->isBroadcastTarget())
-			fSuccess &= pConn->Send(rPkt);
+		{
+			if (fLogged)
+			{
+				pConn->PacketLogCSec.Enter();
+				LockedConns.push_back(pConn);
+			}
+			fSuccess &= pConn->Send(pPkt, false);
+		}
+	// the net i/o classes know the targets as well (see C4Network2IOConnection::SetBroadcastTarget),
+	// so each of them can pack the packet once for all of its peers
+	if (pNetIO_TCP) fSuccess &= pNetIO_TCP->Broadcast(*pPkt);
+	if (pNetIO_UDP) fSuccess &= pNetIO_UDP->Broadcast(*pPkt);
+	for (C4Network2IOConnection *pConn : LockedConns)
+		pConn->PacketLogCSec.Leave();
 	assert(fSuccess);
 	return fSuccess;
 }
@@ -1175,6 +1199,7 @@ void C4Network2IO::GenerateStatistics(int iInterval)
 {
 	int iTCPIRateSum = 0, iTCPORateSum = 0,
 		iUDPIRateSum = 0, iUDPORateSum = 0;
+	size_t iSendQueueSum = 0, iBulkQueueSum = 0;
 
 	// acquire lock, get connection statistics
 	CStdLock ConnListLock(&ConnListCSec);
@@ -1183,7 +1208,7 @@ void C4Network2IO::GenerateStatistics(int iInterval)
 		{
 			bool fTCP = pConn->getNetClass() == pNetIO_TCP;
 			pConn->DoStatistics(iInterval, fTCP ? &iTCPIRateSum : &iUDPIRateSum,
-				fTCP ? &iTCPORateSum : &iUDPORateSum);
+				fTCP ? &iTCPORateSum : &iUDPORateSum, &iSendQueueSum, &iBulkQueueSum);
 		}
 	ConnListLock.Clear();
 
@@ -1207,6 +1232,7 @@ void C4Network2IO::GenerateStatistics(int iInterval)
 	// save back
 	iTCPIRate = iTCPIRateSum; iTCPORate = iTCPORateSum; iTCPBCRate = inTCPBCRate;
 	iUDPIRate = iUDPIRateSum; iUDPORate = iUDPORateSum; iUDPBCRate = inUDPBCRate;
+	iSendQueueSize = iSendQueueSum; iBulkQueueSize = iBulkQueueSum;
 }
 
 void C4Network2IO::SendConnPackets()
@@ -1251,8 +1277,10 @@ C4Network2IOConnection::C4Network2IOConnection()
 	fAutoAccept(false),
 	fBroadcastTarget(false),
 	iTimestamp(0),
-	iPingTime(-1),
+	iPingTime(-1), iAvgPingTime(-1), iPingJitter(-1),
 	iLastPing(~0), iLastPong(~0),
+	iIRate(0), iORate(0), iPacketLoss(0),
+	iSendQueueSize(0), iBulkQueueSize(0),
 	iOutPacketCounter(0), iInPacketCounter(0),
 	pPacketLog(nullptr),
 	pNext(nullptr),
@@ -1283,6 +1311,13 @@ int C4Network2IOConnection::getLag() const
 	return iPingTime;
 }
 
+int C4Network2IOConnection::getPingEstimate() const
+{
+	if (iAvgPingTime < 0) return -1;
+	// the lag of an unanswered ping is known to be exceeded already
+	return (std::max)(iAvgPingTime + 2 * iPingJitter, getLag());
+}
+
 void C4Network2IOConnection::Set(C4NetIO *pnNetClass, C4Network2IOProtocol enProt, const C4NetIO::addr_t &nPeerAddr, const C4NetIO::addr_t &nConnectAddr, C4Network2IOConnStatus nStatus, const char *szPassword, uint32_t inID)
 {
 	// save data
@@ -1293,7 +1328,7 @@ void C4Network2IOConnection::Set(C4NetIO *pnNetClass, C4Network2IOProtocol enPro
 	iID = inID;
 	// initialize
 	fBroadcastTarget = false;
-	iTimestamp = time(nullptr); iPingTime = -1;
+	iTimestamp = time(nullptr); iPingTime = iAvgPingTime = iPingJitter = -1;
 }
 
 void C4Network2IOConnection::SetSocket(std::unique_ptr<C4NetIOTCP::Socket> socket)
@@ -1325,6 +1360,17 @@ void C4Network2IOConnection::SetPingTime(int inPingTime)
 {
 	// save it
 	iPingTime = inPingTime;
+	// smooth like TCP does for its retransmission timeout (RFC 6298)
+	if (iAvgPingTime < 0)
+	{
+		iAvgPingTime = inPingTime;
+		iPingJitter = inPingTime / 2;
+	}
+	else
+	{
+		iPingJitter = (iPingJitter * 3 + std::abs(iAvgPingTime - inPingTime)) / 4;
+		iAvgPingTime = (iAvgPingTime * 7 + inPingTime) / 8;
+	}
 	// pong received - save timestamp
 	iLastPong = timeGetTime();
 }
@@ -1351,7 +1397,7 @@ void C4Network2IOConnection::SetAutoAccepted()
 void C4Network2IOConnection::OnPacketReceived(uint8_t iPacketType)
 {
 	// Just count them
-	if (iPacketType >= PID_PacketLogStart)
+	if (isLoggedPacket(iPacketType))
 		iInPacketCounter++;
 }
 
@@ -1390,7 +1436,7 @@ bool C4Network2IOConnection::CreatePostMortem(C4PacketPostMortem *pPkt)
 	pPkt->SetPacketCounter(iOutPacketCounter);
 	// Add packets
 	for (PacketLogEntry *pEntry = pPacketLog; pEntry; pEntry = pEntry->Next)
-		pPkt->Add(pEntry->Pkt);
+		pPkt->Add(*pEntry->Pkt);
 	// Okay
 	fPostMortemSent = true;
 	return true;
@@ -1425,23 +1471,34 @@ void C4Network2IOConnection::Close()
 
 bool C4Network2IOConnection::Send(const C4NetIOPacket &rPkt)
 {
-	// some packets shouldn't go into the log
-	if (rPkt.getStatus() < PID_PacketLogStart)
+	// some packets shouldn't go into the log (the net i/o class copies the data anyway)
+	if (!isLoggedPacket(rPkt.getStatus()))
 	{
 		assert(isOpen());
-		C4NetIOPacket Copy(rPkt);
-		Copy.SetAddr(PeerAddr);
-		return pNetClass->Send(Copy);
+		if (isBulkPacket(rPkt.getStatus()))
+			return pNetClass->SendBulk(C4NetIOPacket(rPkt.getRef(), PeerAddr));
+		return pNetClass->Send(C4NetIOPacket(rPkt.getRef(), PeerAddr));
+	}
+	return Send(std::make_shared<const C4NetIOPacket>(rPkt.Duplicate()));
+}
+
+bool C4Network2IOConnection::Send(std::shared_ptr<const C4NetIOPacket> pkt, const bool fSendNow)
+{
+	if (!isLoggedPacket(pkt->getStatus()))
+	{
+		assert(isOpen());
+		if (!fSendNow) return true;
+		if (isBulkPacket(pkt->getStatus()))
+			return pNetClass->SendBulk(C4NetIOPacket(pkt->getRef(), PeerAddr));
+		return pNetClass->Send(C4NetIOPacket(pkt->getRef(), PeerAddr));
 	}
 	CStdLock PacketLogLock(&PacketLogCSec);
 	// create log entry
 	PacketLogEntry *pLogEntry = new PacketLogEntry();
 	pLogEntry->Number = iOutPacketCounter++;
-	pLogEntry->Pkt = rPkt;
+	pLogEntry->Pkt = std::move(pkt);
 	pLogEntry->Next = pPacketLog;
 	pPacketLog = pLogEntry;
-	// set address
-	pLogEntry->Pkt.SetAddr(PeerAddr);
 	// closed? No sweat, post mortem will reroute it later.
 	if (!isOpen())
 	{
@@ -1450,8 +1507,9 @@ bool C4Network2IOConnection::Send(const C4NetIOPacket &rPkt)
 		// okay then
 		return true;
 	}
+	if (!fSendNow) return true;
 	// send
-	bool fSuccess = pNetClass->Send(pLogEntry->Pkt);
+	bool fSuccess = pNetClass->Send(C4NetIOPacket(pLogEntry->Pkt->getRef(), PeerAddr));
 	if (fSuccess)
 		assert(!fPostMortemSent);
 	return fSuccess;
@@ -1465,15 +1523,21 @@ void C4Network2IOConnection::SetBroadcastTarget(bool fSet)
 	fBroadcastTarget = fSet;
 }
 
-void C4Network2IOConnection::DoStatistics(int iInterval, int *pIRateSum, int *pORateSum)
+void C4Network2IOConnection::DoStatistics(int iInterval, int *pIRateSum, int *pORateSum, size_t *pSendQueueSum, size_t *pBulkQueueSum)
 {
 	// get C4NetIO statistics
 	int inIRate, inORate, inLoss;
 	if (!isOpen() || !pNetClass->GetConnStatistic(PeerAddr, &inIRate, &inORate, &inLoss))
 	{
 		iIRate = iORate = iPacketLoss = 0;
+		iSendQueueSize = iBulkQueueSize = 0;
 		return;
 	}
+	// queues (protocols without own queues send everything right away)
+	if (!pNetClass->GetConnQueueSize(PeerAddr, &iSendQueueSize, &iBulkQueueSize))
+		iSendQueueSize = iBulkQueueSize = 0;
+	if (pSendQueueSum) *pSendQueueSum += iSendQueueSize;
+	if (pBulkQueueSum) *pBulkQueueSum += iBulkQueueSize;
 	// normalize
 	inIRate = inIRate * 1000 / iInterval;
 	inORate = inORate * 1000 / iInterval;
@@ -1757,6 +1821,36 @@ void C4PacketControlReq::CompileFunc(StdCompiler *pComp)
 	pComp->Value(mkNamingAdapt(mkIntPackAdapt(iCtrlTick), "CtrlTick", -1));
 }
 
+// *** C4PacketControlBatch
+
+void C4PacketControlBatch::Add(const C4GameControlPacket &Ctrl)
+{
+	Ctrls.push_back(std::make_unique<C4GameControlPacket>(Ctrl));
+}
+
+void C4PacketControlBatch::CompileFunc(StdCompiler *pComp)
+{
+	uint32_t iCount = getCount();
+	pComp->Value(mkNamingCountAdapt(iCount, "Ctrl"));
+	if (pComp->isCompiler())
+	{
+		if (iCount > MaxCount)
+			pComp->excCorrupt("control batch too large ({} entries)", iCount);
+		Ctrls.clear();
+		for (uint32_t i = 0; i < iCount; i++)
+			Ctrls.push_back(std::make_unique<C4GameControlPacket>());
+	}
+	// consecutive entries usually belong to the same client and follow tick by tick
+	int32_t iClientID = 0, iCtrlTick = 0;
+	for (const auto &pCtrl : Ctrls)
+	{
+		const auto name = pComp->Name("Ctrl");
+		pComp->Value(mkNamingAdapt(mkIntPackDeltaAdapt(pCtrl->iClientID, iClientID), "ClientID", 0));
+		pComp->Value(mkNamingAdapt(mkIntPackDeltaAdapt(pCtrl->iCtrlTick, iCtrlTick), "CtrlTick", 0));
+		pComp->Value(mkNamingAdapt(pCtrl->Ctrl,                                      "Ctrl"));
+	}
+}
+
 // *** C4PacketActivateReq
 
 void C4PacketActivateReq::CompileFunc(StdCompiler *pComp)
@@ -26,6 +26,7 @@
 
 #include <atomic>
 #include <cstdint>
+#include <memory>
 
 class C4Network2IOConnection;
 
@@ -95,6 +96,7 @@ protected:
 	unsigned long iLastStatistic;
 	int iTCPIRate, iTCPORate, iTCPBCRate,
 		iUDPIRate, iUDPORate, iUDPBCRate;
+	size_t iSendQueueSize, iBulkQueueSize; // (bytes) summed up for all connections
 
 	// punching
 	C4NetIO::addr_t PuncherAddrIPv4, PuncherAddrIPv6;
@@ -152,6 +154,8 @@ public:
 	int getProtIRate (C4Network2IOProtocol eProt) const { return eProt == P_TCP ? iTCPIRate  : iUDPIRate; }
 	int getProtORate (C4Network2IOProtocol eProt) const { return eProt == P_TCP ? iTCPORate  : iUDPORate; }
 	int getProtBCRate(C4Network2IOProtocol eProt) const { return eProt == P_TCP ? iTCPBCRate : iUDPBCRate; }
+	size_t getSendQueueSize() const { return iSendQueueSize; }
+	size_t getBulkQueueSize() const { return iBulkQueueSize; }
 
 	// reference
 	void SetReference(class C4Network2Reference *pReference);
@@ -238,12 +242,14 @@ protected:
 	bool fBroadcastTarget; // broadcast target?
 	time_t iTimestamp; // timestamp of last status change
 	int iPingTime; // ping
+	int iAvgPingTime, iPingJitter; // smoothed ping and its mean deviation (-1 until the first pong)
 	unsigned long iLastPing; // if > iLastPong, it's the first ping that hasn't been answered yet
 	unsigned long iLastPong; // last pong received
 	C4ClientCore CCore; // client core (>= CS_HalfAccepted)
 	CStdCSec CCoreCSec;
 	int iIRate, iORate; // input/output rates (by C4NetIO, in b/s)
 	int iPacketLoss; // lost packets (in the last seconds)
+	size_t iSendQueueSize, iBulkQueueSize; // data waiting to be sent (by C4NetIO, in bytes)
 	StdStrBuf Password; // password to use for connect
 	bool fConnSent; // initial connection packet send
 	bool fPostMortemSent; // post mortem send
@@ -253,7 +259,7 @@ protected:
 	struct PacketLogEntry
 	{
 		uint32_t Number;
-		C4NetIOPacket Pkt;
+		std::shared_ptr<const C4NetIOPacket> Pkt; // may be shared with the logs of other connections
 		PacketLogEntry *Next;
 	};
 	PacketLogEntry *pPacketLog;
@@ -276,14 +282,24 @@ public:
 	int                    getClientID()    const { return CCore.getID(); }
 	bool                   isHost()         const { return CCore.isHost(); }
 	int                    getPingTime()    const { return iPingTime; }
+	int                    getAvgPingTime() const { return iAvgPingTime; }
+	int                    getPingJitter()  const { return iPingJitter; }
+	int                    getPingEstimate() const; // round trip time that is rarely exceeded; -1 if unknown
 	int                    getLag()         const;
 	int                    getPacketLoss()  const { return iPacketLoss; }
+	size_t                 getSendQueueSize() const { return iSendQueueSize; }
+	size_t                 getBulkQueueSize() const { return iBulkQueueSize; }
 	const char            *getPassword()    const { return Password.getData(); }
 	bool                   isConnSent()     const { return fConnSent; }
 
 	uint32_t getInPacketCounter()  const { return iInPacketCounter; }
 	uint32_t getOutPacketCounter() const { return iOutPacketCounter; }
 
+	// Bulk data (resource chunks) is sent behind everything else, so it may be overtaken by packets sent later.
+	// It is neither logged nor counted for the post mortem; lost chunks are requested again.
+	static bool isBulkPacket(uint8_t iPacketType) { return iPacketType == PID_NetResData; }
+	static bool isLoggedPacket(uint8_t iPacketType) { return iPacketType >= PID_PacketLogStart && !isBulkPacket(iPacketType); }
+
 	bool isConnecting()      const { return Status == CS_Connect; }
 	bool isOpen()            const { return Status != CS_Connect && Status != CS_Closed && Status != CS_ConnectFail; }
 	bool isHalfAccepted()    const { return Status == CS_HalfAccepted || Status == CS_Accepted; }
@@ -318,10 +334,11 @@ public:
 	bool Connect();
 	void Close();
 	bool Send(const C4NetIOPacket &rPkt);
+	bool Send(std::shared_ptr<const C4NetIOPacket> pkt, bool fSendNow = true); // shares the data with the packet log; fSendNow = false: log only (caller broadcasts)
 	void SetBroadcastTarget(bool fSet); // (only call after C4Network2IO::BeginBroadcast!)
 
 	// statistics
-	void DoStatistics(int iInterval, int *pIRateSum, int *pORateSum);
+	void DoStatistics(int iInterval, int *pIRateSum, int *pORateSum, size_t *pSendQueueSum, size_t *pBulkQueueSum);
 
 	// reference counting
 	void AddRef(); void DelRef();
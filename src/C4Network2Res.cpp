@@ -23,6 +23,7 @@
 #include <C4Group.h>
 #include <C4Components.h>
 #include <C4Game.h>
+#include <C4ThreadPool.h>
 #include "StdAdaptors.h"
 
 #include <fcntl.h>
@@ -33,6 +34,15 @@
 #endif
 #include <errno.h>
 
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <format>
+#include <semaphore>
+#include <string>
+#include <system_error>
+#include <vector>
+
 // compile debug options
 // #define C4NET2RES_LOAD_ALL
 // #define C4NET2RES_DEBUG_LOG
@@ -70,6 +80,64 @@ public:
 };
 uint32_t DirSizeHelper::iSize, DirSizeHelper::iMaxSize;
 
+// Reads the file once and calculates CRC32, SHA1 and the CRC32 of every part (each may be nullptr) in a pipeline:
+// while the next block is read, the hashes of the previous block are updated on thread pool workers.
+static bool GetFileHashes(const char *szFile, uint32_t *pCRC32, uint8_t *pSHA1, std::vector<uint32_t> *pPartCRCs = nullptr)
+{
+	CStdFile File;
+	if (!File.Open(szFile)) return false;
+
+	// one block per part
+	constexpr size_t BlockSize{C4NetResPartChunks * C4NetResChunkSize};
+	std::array<std::vector<uint8_t>, 2> Blocks{std::vector<uint8_t>(BlockSize), std::vector<uint8_t>(BlockSize)};
+	uint32_t iCRC32{0};
+	StdSha1 SHA1;
+	// each stage works on at most one block at a time, so a block is free again
+	// once both stages have accepted its successor
+	std::binary_semaphore CRCDone{1}, SHADone{1};
+	const auto &threadPool = C4ThreadPool::Global;
+	const auto submit = [&threadPool](std::binary_semaphore &done, auto work)
+	{
+		done.acquire();
+		if (!threadPool)
+		{
+			work();
+			done.release();
+			return;
+		}
+		threadPool->SubmitCallback([&done, work]
+		{
+			work();
+			done.release();
+		});
+	};
+
+	for (size_t iBlock{0}; ; iBlock ^= 1)
+	{
+		uint8_t *const pData{Blocks[iBlock].data()}; size_t iSize{0};
+		if (!File.Read(pData, BlockSize, &iSize))
+			if (!iSize)
+				break;
+		if (pCRC32 || pPartCRCs)
+			submit(CRCDone, [&iCRC32, pPartCRCs, pData, iSize]
+			{
+				const uint32_t iPartCRC32{static_cast<uint32_t>(crc32(0, pData, checked_cast<unsigned int>(iSize)))};
+				iCRC32 = crc32_combine(iCRC32, iPartCRC32, checked_cast<z_off_t>(iSize));
+				if (pPartCRCs) pPartCRCs->emplace_back(iPartCRC32);
+			});
+		if (pSHA1)
+			submit(SHADone, [&SHA1, pData, iSize] { SHA1.Update(pData, iSize); });
+	}
+	// wait for the last blocks
+	CRCDone.acquire();
+	SHADone.acquire();
+	File.Close();
+
+	if (pCRC32) *pCRC32 = iCRC32;
+	if (pSHA1) SHA1.GetHash(pSHA1);
+	return true;
+}
+
 // *** C4Network2ResCore
 
 C4Network2ResCore::C4Network2ResCore()
@@ -87,6 +155,7 @@ void C4Network2ResCore::Set(C4Network2ResType enType, int32_t iResID, const char
 	fLoadable = false;
 	iFileSize = iFileCRC = ~0; iContentsCRC = inContentsCRC;
 	iChunkSize = C4NetResChunkSize;
+	PartCRCs.clear();
 	FileName.Copy(strFileName);
 	Author.Copy(strAuthor);
 }
@@ -107,6 +176,7 @@ void C4Network2ResCore::Clear()
 	Author.Clear();
 	iFileSize = iFileCRC = iContentsCRC = ~0;
 	fHasFileSHA = false;
+	PartCRCs.clear();
 }
 
 // C4PacketBase virtuals
@@ -133,6 +203,8 @@ void C4Network2ResCore::CompileFunc(StdCompiler *pComp)
 		pComp->Value(mkNamingAdapt(iFileCRC,   "FileCRC",   0U));
 		pComp->Value(mkNamingAdapt(iChunkSize, "ChunkSize", C4NetResChunkSize));
 		if (!iChunkSize) pComp->excCorrupt("zero chunk size");
+		pComp->Value(mkNamingAdapt(mkSTLContainerAdapt(PartCRCs), "PartCRCs", std::vector<uint32_t>{}));
+		if (!PartCRCs.empty() && PartCRCs.size() != getPartCnt()) pComp->excCorrupt("{} part CRCs for {} parts", PartCRCs.size(), getPartCnt());
 	}
 	pComp->Value(mkNamingAdapt(iContentsCRC,     "ContentsCRC", 0U));
 	pComp->Value(mkNamingCountAdapt(fHasFileSHA, "FileSHA"));
@@ -145,7 +217,7 @@ void C4Network2ResCore::CompileFunc(StdCompiler *pComp)
 // *** C4Network2ResLoad
 
 C4Network2ResLoad::C4Network2ResLoad(int32_t inChunk, int32_t inByClient)
-	: iChunk(inChunk), iByClient(inByClient), Timestamp(time(nullptr)), pNext(nullptr) {}
+	: iChunk(inChunk), iByClient(inByClient), Timestamp(time(nullptr)), iRequestTime(timeGetTime()), pNext(nullptr) {}
 
 C4Network2ResLoad::~C4Network2ResLoad() {}
 
@@ -154,6 +226,11 @@ bool C4Network2ResLoad::CheckTimeout()
 	return difftime(time(nullptr), Timestamp) >= C4NetResLoadTimeout;
 }
 
+unsigned int C4Network2ResLoad::getLoadTime() const
+{
+	return timeGetTime() - iRequestTime;
+}
+
 // *** C4Network2ResChunkData
 
 C4Network2ResChunkData::C4Network2ResChunkData()
@@ -251,7 +328,22 @@ void C4Network2ResChunkData::Clear()
 	}
 }
 
-int32_t C4Network2ResChunkData::GetChunkToRetrieve(const C4Network2ResChunkData &Available, int32_t iLoadingCnt, int32_t *pLoading) const
+bool C4Network2ResChunkData::isPresent(int32_t iChunk) const
+{
+	for (ChunkRange *pRange = pChunkRanges; pRange && pRange->Start <= iChunk; pRange = pRange->Next)
+		if (iChunk < pRange->Start + pRange->Length)
+			return true;
+	return false;
+}
+
+void C4Network2ResChunkData::CountPresent(int32_t *pCounts) const
+{
+	for (ChunkRange *pRange = pChunkRanges; pRange; pRange = pRange->Next)
+		for (int32_t i = std::max<int32_t>(pRange->Start, 0); i < std::min<int32_t>(pRange->Start + pRange->Length, iChunkCnt); i++)
+			pCounts[i]++;
+}
+
+int32_t C4Network2ResChunkData::GetChunkToRetrieve(const C4Network2ResChunkData &Available, int32_t iLoadingCnt, int32_t *pLoading, const int32_t *pSourceCnt) const
 {
 	// (this version is highly calculation-intensitive, yet the most satisfactory
 	//  solution I could find)
@@ -265,6 +357,26 @@ int32_t C4Network2ResChunkData::GetChunkToRetrieve(const C4Network2ResChunkData
 	if (ChData.isComplete()) return -1;
 	// invert to get everything that should be retrieved
 	C4Network2ResChunkData ChData2; ChData.GetNegative(ChData2);
+	// rarest first: select among the chunks the fewest clients can provide,
+	// so chunks held by one client only get spread before it leaves
+	if (pSourceCnt)
+	{
+		int32_t iMinSourceCnt = INT32_MAX, iCandidateCnt = 0;
+		for (ChunkRange *pRange = ChData2.pChunkRanges; pRange; pRange = pRange->Next)
+			for (int32_t i = pRange->Start; i < pRange->Start + pRange->Length; i++)
+				if (pSourceCnt[i] < iMinSourceCnt)
+				{
+					iMinSourceCnt = pSourceCnt[i]; iCandidateCnt = 1;
+				}
+				else if (pSourceCnt[i] == iMinSourceCnt)
+					iCandidateCnt++;
+		// select chunk (random)
+		int32_t iCandidate = SafeRandom(iCandidateCnt);
+		for (ChunkRange *pRange = ChData2.pChunkRanges; pRange; pRange = pRange->Next)
+			for (int32_t i = pRange->Start; i < pRange->Start + pRange->Length; i++)
+				if (pSourceCnt[i] == iMinSourceCnt && !iCandidate--)
+					return i;
+	}
 	// select chunk (random)
 	int32_t iRetrieveChunk = SafeRandom(ChData2.getPresentChunkCnt());
 	// return
@@ -334,7 +446,7 @@ void C4Network2ResChunkData::CompileFunc(StdCompiler *pComp)
 	{
 		// Create new range / go to next range
 		if (fCompiler)
-			pRange = (pRange ? pRange->Next : pChunkRanges) = new ChunkRange;
+			pRange = (pRange ? pRange->Next : pChunkRanges) = new ChunkRange{};
 		else
 			pRange = pRange ? pRange->Next : pChunkRanges;
 		// Separate
@@ -343,6 +455,9 @@ void C4Network2ResChunkData::CompileFunc(StdCompiler *pComp)
 		pComp->Value(mkIntPackAdapt(pRange->Start));
 		pComp->Separator(StdCompiler::SEP_PART2);
 		pComp->Value(mkIntPackAdapt(pRange->Length));
+		// ranges come from the network and are used as chunk indices
+		if (fCompiler && (pRange->Start < 0 || pRange->Length < 0 || pRange->Length > iChunkCnt - pRange->Start))
+			pComp->excCorrupt("ResChunk range {}+{} out of bounds ({} chunks)!", pRange->Start, pRange->Length, iChunkCnt);
 	}
 	// Terminate list
 	if (fCompiler)
@@ -499,25 +614,33 @@ bool C4Network2Res::SetLoad(const C4Network2ResCore &nCore) // by main thread
 	CStdLock FileLock(&FileCSec);
 	// must be loadable
 	if (!nCore.isLoadable()) return false;
-	// save core, set chunks
+	// save core
 	Core = nCore;
-	Chunks.SetIncomplete(Core.getChunkCnt());
 	// create temporary file
 	if (!pParent->FindTempResFileName(Core.getFileName(), szFile))
 		return false;
+	// identical file loaded before? Then there's nothing left to load
+	// like ressources found locally, this doesn't go through OnResComplete: the caller sees it complete right away,
+	// and it doesn't need to be cached again
+	const bool fCached = pParent->RetrieveFromCache(Core, szFile);
+	// set chunks
+	if (fCached)
+		Chunks.SetComplete(Core.getChunkCnt());
+	else
+		Chunks.SetIncomplete(Core.getChunkCnt());
 #ifdef C4NET2RES_DEBUG_LOG
 	// log
-	pParent->logger->trace("Resource: loading {}:{} to file {}", Core.getID(), Core.getFileName(), szFile);
+	pParent->logger->trace("Resource: loading {}:{} to file {}{}", Core.getID(), Core.getFileName(), szFile, fCached ? " (cached)" : "");
 #endif
 	// set standalone (result is going to be binary-compatible)
 	SCopy(szFile, szStandalone, sizeof(szStandalone) - 1);
 	// set flags
-	fDirty = false;
+	fDirty = fCached;
 	fTempFile = true;
 	fStandaloneFailed = false;
 	fRemoved = false;
 	iLastReqTime = time(nullptr);
-	fLoading = true;
+	fLoading = !fCached;
 	// No discovery yet
 	iDiscoverStartTime = 0;
 	return true;
@@ -673,9 +796,11 @@ bool C4Network2Res::GetStandalone(char *pTo, int32_t iMaxL, bool fSetOfficial, b
 		return false;
 	}
 
-	// calc checksum
+	// calc checksum; the official version also gets its hash and part checksums in the same pass
 	uint32_t iCRC32;
-	if (!C4Group_GetFileCRC(szStandalone, &iCRC32))
+	uint8_t hash[StdSha1::DigestLength];
+	std::vector<uint32_t> PartCRCs;
+	if (!GetFileHashes(szStandalone, &iCRC32, fSetOfficial ? hash : nullptr, fSetOfficial ? &PartCRCs : nullptr))
 	{
 		if (!fSilent) pParent->logger->error("GetStandalone: could not calculate checksum!"); return false;
 	}
@@ -691,6 +816,11 @@ bool C4Network2Res::GetStandalone(char *pTo, int32_t iMaxL, bool fSetOfficial, b
 	fStandaloneFailed = false;
 	// mark resource as loadable and safe file information
 	Core.SetLoadable(iSize, iCRC32);
+	if (fSetOfficial)
+	{
+		Core.SetFileSHA(hash);
+		Core.SetPartCRCs(std::move(PartCRCs));
+	}
 	// set up chunk data
 	Chunks.SetComplete(Core.getChunkCnt());
 	// ok
@@ -703,11 +833,12 @@ bool C4Network2Res::CalculateSHA()
 	if (Core.hasFileSHA()) return true;
 	// get the file
 	char szStandalone[_MAX_PATH + 1];
-	if (!GetStandalone(szStandalone, _MAX_PATH, false))
+	const bool fStandalone{GetStandalone(szStandalone, _MAX_PATH, false)};
+	if (!fStandalone)
 		SCopy(szFile, szStandalone, _MAX_PATH);
-	// get the hash
+	// get the hash (the original file might be packed)
 	uint8_t hash[StdSha1::DigestLength];
-	if (!C4Group_GetFileSHA1(szStandalone, hash))
+	if (!(fStandalone ? GetFileHashes(szStandalone, nullptr, hash) : C4Group_GetFileSHA1(szStandalone, hash)))
 		return false;
 	// save it back
 	Core.SetFileSHA(hash);
@@ -849,6 +980,8 @@ bool C4Network2Res::SendChunk(uint32_t iChunk, int32_t iToClient)
 {
 	assert(pParent && pParent->getIOClass());
 	if (!szStandalone[0] || iChunk >= Core.getChunkCnt()) return false;
+	// while loading, only verified chunks are offered
+	if (fLoading && !Chunks.isPresent(iChunk)) return false;
 	// find connection for given client (one of the rare uses of the data connection)
 	C4Network2IOConnection *pConn = pParent->getIOClass()->GetDataConnection(iToClient);
 	if (!pConn) return false;
@@ -901,11 +1034,12 @@ void C4Network2Res::OnStatus(const C4Network2ResChunkData &rChunkData, C4Network
 		pChunks = new ClientChunks();
 		pChunks->Next = pCChunks;
 		pCChunks = pChunks;
+		pChunks->LoadWindow = C4NetResInitialLoadWindow;
 	}
 	pChunks->ClientID = pBy->getClientID();
 	pChunks->Chunks = rChunkData;
 	// load?
-	if (fLoading) StartLoad(pChunks->ClientID, pChunks->Chunks);
+	if (fLoading) StartLoad(*pChunks);
 }
 
 void C4Network2Res::OnChunk(const C4Network2ResChunk &rChunk)
@@ -922,6 +1056,8 @@ void C4Network2Res::OnChunk(const C4Network2ResChunk &rChunk)
 #endif
 	if (fSuccess)
 	{
+		// parts are only added to the chunks once verified
+		if (Core.hasPartCRCs()) VerifyPart(rChunk.getChunkNr() / C4NetResPartChunks);
 		// status changed
 		fDirty = true;
 		// remove load waits
@@ -929,7 +1065,10 @@ void C4Network2Res::OnChunk(const C4Network2ResChunk &rChunk)
 		{
 			pNext = pLoad->Next();
 			if (pLoad->getChunk() == rChunk.getChunkNr())
+			{
+				OnLoadDone(*pLoad, false);
 				RemoveLoad(pLoad);
+			}
 		}
 	}
 	// complete?
@@ -953,6 +1092,7 @@ bool C4Network2Res::DoLoad()
 			pNext = pLoad->Next();
 			if (pLoad->CheckTimeout())
 			{
+				OnLoadDone(*pLoad, true);
 				RemoveLoad(pLoad);
 				iLoadsRemoved++;
 			}
@@ -1048,7 +1188,7 @@ void C4Network2Res::StartNewLoads()
 			if (pC[i])
 			{
 				// try to start load
-				if (!StartLoad(pC[i]->ClientID, pC[i]->Chunks))
+				if (!StartLoad(*pC[i]))
 				{
 					pC[i] = nullptr; continue;
 				}
@@ -1063,26 +1203,34 @@ void C4Network2Res::StartNewLoads()
 	delete[] pC;
 }
 
-bool C4Network2Res::StartLoad(int32_t iFromClient, const C4Network2ResChunkData &Available)
+bool C4Network2Res::StartLoad(ClientChunks &From)
 {
 	assert(pParent && pParent->getIOClass());
+	const int32_t iFromClient = From.ClientID;
 	// all slots used? ignore
 	if (iLoadCnt + 1 >= C4NetResMaxLoad) return true;
 	int32_t loadsAtClient = 0;
-	// are there already enough loads by this client? ignore
+	// window of this client full? ignore
 	for (C4Network2ResLoad *pPos = pLoads; pPos; pPos = pPos->Next())
 	{
 		if (pPos->getByClient() == iFromClient)
 		{
-			if (++loadsAtClient >= C4NetResMaxLoadPerPeerPerFile)
+			if (++loadsAtClient >= From.LoadWindow)
 				return true;
 		}
 	}
-	// find chunk to retrieve
+	// count sources per chunk
+	std::vector<int32_t> SourceCnt(Chunks.getChunkCnt());
+	for (ClientChunks *pChunks = pCChunks; pChunks; pChunks = pChunks->Next)
+		pChunks->Chunks.CountPresent(SourceCnt.data());
+	// find chunk to retrieve; chunks waiting for the rest of their part are there already
 	int32_t iLoads[C4NetResMaxLoad]; int32_t i = 0;
 	for (C4Network2ResLoad *pLoad = pLoads; pLoad; pLoad = pLoad->Next())
 		iLoads[i++] = pLoad->getChunk();
-	int32_t iRetrieveChunk = Chunks.GetChunkToRetrieve(Available, i, iLoads);
+	C4Network2ResChunkData Present(Chunks);
+	for (const int32_t iChunk : PendingChunks)
+		Present.AddChunk(iChunk);
+	int32_t iRetrieveChunk = Present.GetChunkToRetrieve(From.Chunks, i, iLoads, SourceCnt.data());
 	// nothing? ignore
 	if (iRetrieveChunk < 0 || static_cast<uint32_t>(iRetrieveChunk) >= Core.getChunkCnt())
 		return true;
@@ -1127,6 +1275,7 @@ void C4Network2Res::ClearLoad()
 	fLoading = false;
 	while (pCChunks) RemoveCChunks(pCChunks);
 	while (pLoads) RemoveLoad(pLoads);
+	PendingChunks.clear();
 	iDiscoverStartTime = iLoadCnt = 0;
 }
 
@@ -1165,6 +1314,62 @@ void C4Network2Res::RemoveCChunks(ClientChunks *pChunks)
 	delete pChunks;
 }
 
+C4Network2Res::ClientChunks *C4Network2Res::GetCChunks(int32_t iClientID) const
+{
+	for (ClientChunks *pChunks = pCChunks; pChunks; pChunks = pChunks->Next)
+		if (pChunks->ClientID == iClientID)
+			return pChunks;
+	return nullptr;
+}
+
+void C4Network2Res::OnLoadDone(const C4Network2ResLoad &Load, bool fTimeout)
+{
+	ClientChunks *pChunks = GetCChunks(Load.getByClient());
+	if (!pChunks) return;
+	// slow or lost: the link to this client is congested, back off
+	if (fTimeout || Load.getLoadTime() > C4NetResLoadTargetTime)
+	{
+		pChunks->LoadWindow = std::max<int32_t>(pChunks->LoadWindow / 2, 1);
+		pChunks->LoadWindowAcks = 0;
+	}
+	// otherwise, grow by one request per window's worth of chunks
+	else if (++pChunks->LoadWindowAcks >= pChunks->LoadWindow)
+	{
+		pChunks->LoadWindow = std::min<int32_t>(pChunks->LoadWindow + 1, C4NetResMaxLoadWindow);
+		pChunks->LoadWindowAcks = 0;
+	}
+}
+
+void C4Network2Res::VerifyPart(const uint32_t iPart)
+{
+	const int32_t iStart{checked_cast<int32_t>(iPart * C4NetResPartChunks)};
+	const int32_t iEnd{std::min<int32_t>(iStart + C4NetResPartChunks, Core.getChunkCnt())};
+	const auto isInPart = [iStart, iEnd](const int32_t iChunk) { return iChunk >= iStart && iChunk < iEnd; };
+	// wait for the whole part
+	for (int32_t iChunk{iStart}; iChunk < iEnd; ++iChunk)
+		if (std::ranges::find(PendingChunks, iChunk) == PendingChunks.end())
+			return;
+	std::erase_if(PendingChunks, isInPart);
+	// read it back
+	const uint32_t iOffset{iStart * Core.getChunkSize()};
+	const uint32_t iSize{std::min(Core.getFileSize() - iOffset, C4NetResPartChunks * Core.getChunkSize())};
+	std::vector<uint8_t> Data(iSize);
+	bool fRead{false};
+	if (const int32_t f{open(szStandalone, _O_BINARY | O_RDONLY)}; f != -1)
+	{
+		fRead = lseek(f, iOffset, SEEK_SET) == static_cast<off_t>(iOffset) && read(f, Data.data(), iSize) == static_cast<ssize_t>(iSize);
+		close(f);
+	}
+	// corrupt? load it again
+	if (!fRead || crc32(0, Data.data(), iSize) != Core.getPartCRC(iPart))
+	{
+		pParent->logger->warn("part {} of {} is corrupt, loading it again", iPart, Core.getFileName());
+		return;
+	}
+	// verified: offer it to others
+	Chunks.AddChunkRange(iStart, iEnd - iStart);
+}
+
 bool C4Network2Res::OptimizeStandalone(bool fSilent)
 {
 	CStdLock FileLock(&FileCSec);
@@ -1235,7 +1440,7 @@ bool C4Network2ResChunk::Set(C4Network2Res *pRes, uint32_t inChunk)
 	iChunk = inChunk;
 	// calculate offset and size
 	int32_t iOffset = iChunk * Core.getChunkSize(),
-		iSize = std::min<int32_t>(Core.getFileSize() - iOffset, C4NetResChunkSize);
+		iSize = std::min<int32_t>(Core.getFileSize() - iOffset, Core.getChunkSize());
 	if (iSize < 0) { logger->error("could not get chunk from offset {} from resource file {}: File size is only {}!", iOffset, pRes->getFile(), Core.getFileSize()); return false; }
 	// open file
 	int32_t f = pRes->OpenFileRead();
@@ -1284,6 +1489,9 @@ bool C4Network2ResChunk::AddTo(C4Network2Res *pRes, C4Network2IO *pIO) const
 #endif
 		return false;
 	}
+	// a verified part is not overwritten
+	if (Core.hasPartCRCs() && pRes->Chunks.isPresent(iChunk))
+		return true;
 	// open file
 	int32_t f = pRes->OpenFileWrite();
 	if (f == -1)
@@ -1312,9 +1520,12 @@ bool C4Network2ResChunk::AddTo(C4Network2Res *pRes, C4Network2IO *pIO) const
 		close(f);
 		return false;
 	}
-	// ok, add chunks
+	// ok, add chunks; with part checksums, they wait for the rest of their part
 	close(f);
-	pRes->Chunks.AddChunk(iChunk);
+	if (Core.hasPartCRCs())
+		pRes->PendingChunks.emplace_back(iChunk);
+	else
+		pRes->Chunks.AddChunk(iChunk);
 	return true;
 }
 
@@ -1458,11 +1669,16 @@ C4Network2Res::Ref C4Network2ResList::AddByFile(const char *strFilePath, bool fT
 	// create standalone for non-system files
 	// system files shouldn't create a standalone; they should never be marked loadable!
 	if (eType != NRT_System)
+	{
+		// this calculates the hash clients look up their ressource cache by, too
 		if (!res->GetStandalone(nullptr, 0, true, fAllowUnloadable))
+		{
 			if (!fAllowUnloadable)
 			{
 				return nullptr;
 			}
+		}
+	}
 
 	// add to list
 	const auto resPtr = res.release();
@@ -1510,7 +1726,10 @@ C4Network2Res::Ref C4Network2ResList::AddLoad(const C4Network2ResCore &Core) //
 	// initialize
 	pRes->SetLoad(Core);
 	// log
-	logger->info("loading {}...", Core.getFileName());
+	if (pRes->isComplete())
+		logger->info("Found {} in ressource cache. Not loading.", Core.getFileName());
+	else
+		logger->info("loading {}...", Core.getFileName());
 	// add to list
 	Add(pRes);
 	return pRes;
@@ -1710,6 +1929,8 @@ void C4Network2ResList::OnResComplete(C4Network2Res *pRes)
 {
 	// log
 	logger->info("{} received.", pRes->getCore().getFileName());
+	// keep it for later sessions
+	AddToCache(pRes->getCore(), pRes->getFile());
 	// call handler (ctrl might wait for this ressource)
 	Game.Control.Network.OnResComplete(pRes);
 }
@@ -1800,6 +2021,122 @@ bool C4Network2ResList::FindTempResFileName(const char *szFilename, char *pTarge
 	return false;
 }
 
+bool C4Network2ResList::IsCacheable(const C4Network2ResCore &Core)
+{
+	// dynamic data changes with every game; system files are never loaded
+	switch (Core.getType())
+	{
+	case NRT_Scenario: case NRT_Player: case NRT_Definitions: case NRT_Material:
+		return Core.isLoadable();
+	default:
+		return false;
+	}
+}
+
+std::string C4Network2ResList::GetCacheFilename(const C4Network2ResCore &Core) const
+{
+	std::string filename{Config.AtNetworkPath(C4CFN_NetResCache)};
+	filename += DirSep;
+	for (std::size_t i{0}; i < StdSha1::DigestLength; ++i)
+		filename += std::format("{:02x}", Core.getFileSHA()[i]);
+	filename += std::format("_{}", Core.getFileSize());
+	return filename;
+}
+
+bool C4Network2ResList::RetrieveFromCache(const C4Network2ResCore &Core, const char *szTarget) // by main thread
+{
+	if (Config.Network.ResCacheSize <= 0 || !IsCacheable(Core) || !Core.hasFileSHA()) return false;
+	// entries only appear complete (see CopyToCache), so no lock is needed
+	const std::string cacheFilename{GetCacheFilename(Core)};
+	if (!FileExists(cacheFilename.c_str())) return false;
+	// copy it to the target, so the loaded file doesn't share its data with the cache; the temporary file may already exist
+	EraseFile(szTarget);
+	if (!CopyItem(cacheFilename.c_str(), szTarget))
+	{
+		CreateItem(szTarget);
+		return false;
+	}
+	// the cache might have been tampered with
+	uint32_t iCRC32;
+	if (FileSize(szTarget) != Core.getFileSize() || !C4Group_GetFileCRC(szTarget, &iCRC32) || iCRC32 != Core.getFileCRC())
+	{
+		logger->warn("Ressource cache entry for {} is damaged", Core.getFileName());
+		EraseFile(szTarget);
+		CreateItem(szTarget);
+		EraseFile(cacheFilename.c_str());
+		return false;
+	}
+	// mark as recently used
+	std::error_code ec;
+	std::filesystem::last_write_time(cacheFilename, std::filesystem::file_time_type::clock::now(), ec);
+	return true;
+}
+
+void C4Network2ResList::AddToCache(const C4Network2ResCore &Core, const char *szFile) // by both
+{
+	if (Config.Network.ResCacheSize <= 0 || !IsCacheable(Core) || !Core.hasFileSHA()) return;
+	std::string cacheFilename{GetCacheFilename(Core)};
+	if (FileExists(cacheFilename.c_str())) return;
+	// copying and trimming may take a while, so it's done on the thread pool
+	auto copy = [logger{logger}, Core, file{std::string{szFile}}, cachePath{std::string{Config.AtNetworkPath(C4CFN_NetResCache)}},
+		cacheFilename{std::move(cacheFilename)}, iMaxSize{static_cast<uint64_t>(Config.Network.ResCacheSize) * 1024 * 1024}]
+	{
+		CopyToCache(*logger, Core, file, cachePath, cacheFilename, iMaxSize);
+	};
+	if (const auto &threadPool = C4ThreadPool::Global)
+		threadPool->SubmitCallback(std::move(copy));
+	else
+		copy();
+}
+
+void C4Network2ResList::CopyToCache(spdlog::logger &logger, const C4Network2ResCore &Core, const std::string &file, const std::string &cachePath, const std::string &cacheFilename, uint64_t iMaxSize) // by thread pool
+{
+	CStdLock CacheLock(&CacheCSec);
+	if (FileExists(cacheFilename.c_str())) return;
+	// create directory
+	if (!DirectoryExists(cachePath.c_str()) && !MakeDirectory(cachePath.c_str(), nullptr))
+	{
+		logger.error("Could not create ressource cache directory {}", cachePath);
+		return;
+	}
+	// copy under a temporary name first, so incomplete entries are never found;
+	// the ressource file may have been changed or removed in the meantime, so check the copy
+	const std::string tempFilename{cacheFilename + ".tmp"};
+	uint32_t iCRC32;
+	if (!CopyItem(file.c_str(), tempFilename.c_str())
+		|| FileSize(tempFilename.c_str()) != Core.getFileSize()
+		|| !C4Group_GetFileCRC(tempFilename.c_str(), &iCRC32) || iCRC32 != Core.getFileCRC()
+		|| !RenameFile(tempFilename.c_str(), cacheFilename.c_str()))
+	{
+		logger.error("Could not add {} to ressource cache", Core.getFileName());
+		EraseFile(tempFilename.c_str());
+		return;
+	}
+	TrimCache(cachePath, iMaxSize);
+}
+
+void C4Network2ResList::TrimCache(const std::string &cachePath, uint64_t iMaxSize) // by thread pool
+{
+	// collect entries
+	std::vector<std::pair<time_t, std::string>> entries;
+	uint64_t iTotalSize = 0;
+	for (DirectoryIterator i(cachePath.c_str()); *i; ++i)
+		if (!DirectoryExists(*i))
+		{
+			entries.emplace_back(FileTime(*i), *i);
+			iTotalSize += FileSize(*i);
+		}
+	// remove least recently used entries
+	std::ranges::sort(entries);
+	for (const auto &[time, filename] : entries)
+	{
+		if (iTotalSize <= iMaxSize) break;
+		const size_t iSize = FileSize(filename.c_str());
+		if (EraseFile(filename.c_str()))
+			iTotalSize -= std::min<uint64_t>(iSize, iTotalSize);
+	}
+}
+
 int32_t C4Network2ResList::GetClientProgress(int32_t clientID)
 {
 	int32_t sumPresentChunkCnt = 0, sumChunkCnt = 0;
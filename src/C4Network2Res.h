@@ -23,14 +23,19 @@
 #include <StdSync.h>
 
 #include <atomic>
+#include <string>
+#include <vector>
 
-const uint32_t C4NetResChunkSize = 100U * 1024U;
+const uint32_t C4NetResChunkSize = 100U * 1024U,
+               C4NetResPartChunks = 10; // chunks per part; loaded parts are verified by their own CRC
 
 const int32_t C4NetResDiscoverTimeout = 10, // (s)
               C4NetResDiscoverInterval = 1, // (s)
               C4NetResStatusInterval = 1, // (s)
-              C4NetResMaxLoadPerPeerPerFile = 3,
-              C4NetResMaxLoad = 20,
+              C4NetResInitialLoadWindow = 3, // outstanding chunk requests per source
+              C4NetResMaxLoadWindow = 16,
+              C4NetResMaxLoad = 32,
+              C4NetResLoadTargetTime = 2000, // (ms) chunks taking longer shrink the window of their source
               C4NetResLoadTimeout = 60, // (s)
               C4NetResDeleteTime = 60, // (s)
               C4NetResMaxBigicon = 20; // maximum size, in KB, of bigicon
@@ -69,6 +74,7 @@ protected:
 	uint8_t fHasFileSHA;
 	uint8_t FileSHA[StdSha1::DigestLength];
 	uint32_t iChunkSize;
+	std::vector<uint32_t> PartCRCs; // empty if unknown
 
 public:
 	C4Network2ResType getType()        const { return eType; }
@@ -80,15 +86,20 @@ public:
 	uint32_t          getFileCRC()     const { return iFileCRC; }
 	uint32_t          getContentsCRC() const { return iContentsCRC; }
 	bool              hasFileSHA()     const { return !!fHasFileSHA; }
+	const uint8_t    *getFileSHA()     const { return FileSHA; }
 	const char       *getFileName()    const { return FileName.getData(); }
 	uint32_t          getChunkSize()   const { return iChunkSize; }
 	uint32_t          getChunkCnt()    const { return iFileSize && iChunkSize ? (iFileSize - 1) / iChunkSize + 1 : 0; }
+	uint32_t          getPartCnt()     const { return getChunkCnt() ? (getChunkCnt() - 1) / C4NetResPartChunks + 1 : 0; }
+	bool              hasPartCRCs()    const { return !PartCRCs.empty(); }
+	uint32_t          getPartCRC(uint32_t iPart) const { return PartCRCs[iPart]; }
 
 	void Set(C4Network2ResType eType, int32_t iResID, const char *strFileName, uint32_t iContentsCRC, const char *szAutor);
 	void SetID(int32_t inID) { iID = inID; }
 	void SetDerived(int32_t inDerID) { iDerID = inDerID; }
 	void SetLoadable(uint32_t iSize, uint32_t iCRC);
 	void SetFileSHA(uint8_t *pSHA) { memcpy(FileSHA, pSHA, StdSha1::DigestLength); fHasFileSHA = true; }
+	void SetPartCRCs(std::vector<uint32_t> &&nPartCRCs) { PartCRCs = std::move(nPartCRCs); }
 	void Clear();
 
 	virtual void CompileFunc(StdCompiler *pComp) override;
@@ -106,6 +117,7 @@ protected:
 	// chunk download data
 	int32_t iChunk;
 	time_t Timestamp;
+	unsigned int iRequestTime; // (ms)
 	int32_t iByClient;
 
 	// list (C4Network2Res)
@@ -114,6 +126,7 @@ protected:
 public:
 	int32_t getChunk()    const { return iChunk; }
 	int32_t getByClient() const { return iByClient; }
+	unsigned int getLoadTime() const; // (ms) since the request
 
 	C4Network2ResLoad *Next() const { return pNext; }
 
@@ -142,6 +155,7 @@ public:
 	int32_t getPresentChunkCnt() const { return iPresentChunkCnt; }
 	int32_t getPresentPercent()  const { return iPresentChunkCnt * 100 / iChunkCnt; }
 	bool    isComplete()         const { return iPresentChunkCnt == iChunkCnt; }
+	bool    isPresent(int32_t iChunk) const;
 
 	void SetIncomplete(int32_t iChunkCnt);
 	void SetComplete(int32_t iChunkCnt);
@@ -152,7 +166,8 @@ public:
 
 	void Clear();
 
-	int32_t GetChunkToRetrieve(const C4Network2ResChunkData &Available, int32_t iLoadingCnt, int32_t *pLoading) const;
+	void CountPresent(int32_t *pCounts) const; // increments the counter of every present chunk
+	int32_t GetChunkToRetrieve(const C4Network2ResChunkData &Available, int32_t iLoadingCnt, int32_t *pLoading, const int32_t *pSourceCnt = nullptr) const;
 
 protected:
 	// helpers
@@ -199,6 +214,7 @@ protected:
 	// core, chunk data
 	C4Network2ResCore Core;
 	C4Network2ResChunkData Chunks; // (only valid while loading)
+	std::vector<int32_t> PendingChunks; // loaded, but not part of a verified part yet
 	bool fDirty;
 
 	// local file data
@@ -218,7 +234,12 @@ protected:
 
 	// not savable if true
 	bool local{false};
-	struct ClientChunks { C4Network2ResChunkData Chunks; int32_t ClientID; ClientChunks *Next; }
+	struct ClientChunks
+	{
+		C4Network2ResChunkData Chunks; int32_t ClientID; ClientChunks *Next;
+		// congestion window: maximum number of outstanding requests to this client
+		int32_t LoadWindow, LoadWindowAcks;
+	}
 	*pCChunks;
 	time_t iDiscoverStartTime;
 	C4Network2ResLoad *pLoads;
@@ -283,12 +304,15 @@ protected:
 	int32_t OpenFileRead(); int32_t OpenFileWrite();
 
 	void StartNewLoads();
-	bool StartLoad(int32_t iFromClient, const C4Network2ResChunkData &Chunks);
+	bool StartLoad(ClientChunks &From);
 	void EndLoad();
 	void ClearLoad();
 
 	void RemoveLoad(C4Network2ResLoad *pLoad);
 	void RemoveCChunks(ClientChunks *pChunks);
+	ClientChunks *GetCChunks(int32_t iClientID) const;
+	void OnLoadDone(const C4Network2ResLoad &Load, bool fTimeout);
+	void VerifyPart(uint32_t iPart);
 
 	bool OptimizeStandalone(bool fSilent);
 };
@@ -337,6 +361,9 @@ protected:
 	// object used for network i/o
 	C4Network2IO *pIO;
 
+	// persistent cache of loaded ressources, addressed by content; serializes additions on the thread pool
+	static inline CStdCSec CacheCSec;
+
 	// logger
 	std::shared_ptr<spdlog::logger> logger;
 
@@ -389,6 +416,14 @@ protected:
 	// misc
 	bool CreateNetworkFolder();
 	bool FindTempResFileName(const char *szFilename, char *pTarget);
+
+	// ressource cache
+	static bool IsCacheable(const C4Network2ResCore &Core);
+	std::string GetCacheFilename(const C4Network2ResCore &Core) const;
+	bool RetrieveFromCache(const C4Network2ResCore &Core, const char *szTarget); // by main thread
+	void AddToCache(const C4Network2ResCore &Core, const char *szFile); // by both
+	static void CopyToCache(spdlog::logger &logger, const C4Network2ResCore &Core, const std::string &file, const std::string &cachePath, const std::string &cacheFilename, uint64_t iMaxSize); // by thread pool
+	static void TrimCache(const std::string &cachePath, uint64_t iMaxSize); // by thread pool
 };
 
 // Packets
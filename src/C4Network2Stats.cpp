@@ -306,6 +306,17 @@ C4Network2Stats::C4Network2Stats() : pSec1Timer(nullptr)
 	statNetO.SetTitle(LoadResStr(C4ResStrTableKey::IDS_NET_OUTPUT));
 	statNetO.SetColorDw(0xff0000);
 	graphNetIO.AddGraph(&statNetI); graphNetIO.AddGraph(&statNetO);
+	statControlRate.SetTitle(LoadResStr(C4ResStrTableKey::IDS_NET_CONTROLRATE_GRAPH));
+	statControlRate.SetColorDw(0xffff00);
+	statPreSend.SetTitle(LoadResStr(C4ResStrTableKey::IDS_NET_CONTROL_PRESEND));
+	statPreSend.SetColorDw(0x00ffff);
+	graphNetControl.AddGraph(&statControlRate); graphNetControl.AddGraph(&statPreSend);
+	statControlSendTime.SetTitle(LoadResStr(C4ResStrTableKey::IDS_NET_CONTROL_PING));
+	statSendQueue.SetTitle(LoadResStr(C4ResStrTableKey::IDS_NET_SENDQUEUE));
+	statSendQueue.SetColorDw(0xff0000);
+	statBulkQueue.SetTitle(LoadResStr(C4ResStrTableKey::IDS_NET_SENDQUEUE_BULK));
+	statBulkQueue.SetColorDw(0x0000ff);
+	graphNetQueue.AddGraph(&statSendQueue); graphNetQueue.AddGraph(&statBulkQueue);
 	statControls.SetTitle(LoadResStr(C4ResStrTableKey::IDS_NET_CONTROL));
 	statControls.SetAverageTime(100);
 	statActions.SetTitle(LoadResStr(C4ResStrTableKey::IDS_NET_APM));
@@ -333,6 +344,13 @@ void C4Network2Stats::ExecuteSecond()
 	statFPS.RecordValue(C4Graph::ValueType(Game.FPS));
 	statNetI.RecordValue(C4Graph::ValueType(Game.Network.NetIO.getProtIRate(P_TCP) + Game.Network.NetIO.getProtIRate(P_UDP)));
 	statNetO.RecordValue(C4Graph::ValueType(Game.Network.NetIO.getProtORate(P_TCP) + Game.Network.NetIO.getProtORate(P_UDP)));
+	// control timing
+	statControlRate.RecordValue(C4Graph::ValueType(Game.Control.ControlRate));
+	statPreSend.RecordValue(C4Graph::ValueType(Game.Control.Network.getControlPreSend()));
+	statControlSendTime.RecordValue(C4Graph::ValueType(Game.Control.Network.getAvgControlSendTime() / 1000));
+	// send queues
+	statSendQueue.RecordValue(C4Graph::ValueType(Game.Network.NetIO.getSendQueueSize() / 1024));
+	statBulkQueue.RecordValue(C4Graph::ValueType(Game.Network.NetIO.getBulkQueueSize() / 1024));
 	// pings for all clients
 	C4Network2Client *pClient = nullptr;
 	while (pClient = Game.Network.Clients.GetNextClient(pClient)) if (pClient->getStatPing())
@@ -374,6 +392,9 @@ C4Graph *C4Network2Stats::GetGraphByName(const StdStrBuf &rszName, bool &rfIsTem
 	if (SEqualNoCase(rszName.getData(), "oc")) return &statObjCount;
 	if (SEqualNoCase(rszName.getData(), "fps")) return &statFPS;
 	if (SEqualNoCase(rszName.getData(), "netio")) return &graphNetIO;
+	if (SEqualNoCase(rszName.getData(), "netcontrol")) return &graphNetControl;
+	if (SEqualNoCase(rszName.getData(), "controlping")) return &statControlSendTime;
+	if (SEqualNoCase(rszName.getData(), "netqueue")) return &graphNetQueue;
 	if (SEqualNoCase(rszName.getData(), "pings")) return &statPings;
 	if (SEqualNoCase(rszName.getData(), "control")) return &statControls;
 	if (SEqualNoCase(rszName.getData(), "apm")) return &statActions;
@@ -179,6 +179,15 @@ private:
 	C4TableGraph statNetI, statNetO;
 	C4GraphCollection graphNetIO;
 
+	// network control timing (frames); automatic adjustments show up as steps
+	C4TableGraph statControlRate, statPreSend;
+	C4GraphCollection graphNetControl;
+	C4TableGraph statControlSendTime; // (ms)
+
+	// data waiting in the send queues of all connections (KB); bulk is resource data that yields to everything else
+	C4TableGraph statSendQueue, statBulkQueue;
+	C4GraphCollection graphNetQueue;
+
 protected:
 	C4GraphCollection statPings; // for all clients
 
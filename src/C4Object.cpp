@@ -143,6 +143,7 @@ void C4Object::Default()
 	pGraphics = nullptr;
 	pDrawTransform = nullptr;
 	pEffects = nullptr;
+	EffectListState = {};
 	FirstRef = nullptr;
 	pGfxOverlay = nullptr;
 	iLastAttachMovementFrame = -1;
@@ -1285,7 +1286,7 @@ void C4Object::DoDamage(int32_t iChange, int32_t iCausedBy, int32_t iCause)
 	// Change value
 	Damage = std::max<int32_t>(Damage + iChange, 0);
 	// Engine script call
-	Call(PSF_Damage, {C4VInt(iChange), C4VInt(iCausedBy)});
+	Call(C4DefScriptHost::CB_Damage, {C4VInt(iChange), C4VInt(iCausedBy)});
 }
 
 // returns x * y, but returns std::numeric_limits<T>::min() or std::numeric_limits<T>::max() in case of a negative or positive overflow respectively
@@ -1531,7 +1532,7 @@ bool C4Object::Exit(int32_t iX, int32_t iY, int32_t iR, C4Fixed iXDir, C4Fixed i
 	SetOCF();
 	// Engine calls
 	if (fCalls) pContainer->Call(PSF_Ejection, {C4VObj(this)});
-	if (fCalls) Call(PSF_Departure, {C4VObj(pContainer)});
+	if (fCalls) Call(C4DefScriptHost::CB_Departure, {C4VObj(pContainer)});
 	// Success (if the obj wasn't "re-entered" by script)
 	return !Contained;
 }
@@ -1555,7 +1556,7 @@ bool C4Object::Enter(C4Object *pTarget, bool fCalls, bool fCopyMotion, bool *pfR
 	// Check RejectCollect, if desired
 	if (pfRejectCollect)
 	{
-		if (pTarget->Call(PSF_RejectCollection, {C4VID(Def->id), C4VObj(this)}))
+		if (pTarget->Call(C4DefScriptHost::CB_RejectCollection, {C4VID(Def->id), C4VObj(this)}))
 		{
 			*pfRejectCollect = true;
 			return false;
@@ -1596,10 +1597,10 @@ bool C4Object::Enter(C4Object *pTarget, bool fCalls, bool fCopyMotion, bool *pfR
 	Contained->UpdateMass();
 	Contained->SetOCF();
 	// Collection call
-	if (fCalls) pTarget->Call(PSF_Collection2, {C4VObj(this)});
+	if (fCalls) pTarget->Call(C4DefScriptHost::CB_Collection2, {C4VObj(this)});
 	if (!Contained || !Contained->Status || !pTarget->Status) return true;
 	// Entrance call
-	if (fCalls) Call(PSF_Entrance, {C4VObj(Contained)});
+	if (fCalls) Call(C4DefScriptHost::CB_Entrance, {C4VObj(Contained)});
 	if (!Contained || !Contained->Status || !pTarget->Status) return true;
 	// Base auto sell contents
 	if (ValidPlr(Contained->Base))
@@ -1801,7 +1802,7 @@ bool C4Object::Push(C4Fixed txdir, C4Fixed dforce, bool fStraighten)
 		if (ContactCheck(x, y)) // Resets t_contact
 		{
 			GameMsgObject(LoadResStr(C4ResStrTableKey::IDS_OBJ_STUCK, GetName()).c_str(), this);
-			Call(PSF_Stuck);
+			Call(C4DefScriptHost::CB_Stuck);
 		}
 
 	return true;
@@ -1831,7 +1832,7 @@ bool C4Object::Lift(C4Fixed tydir, C4Fixed dforce)
 		if (ContactCheck(x, y)) // Resets t_contact
 		{
 			GameMsgObject(LoadResStr(C4ResStrTableKey::IDS_OBJ_STUCK, GetName()).c_str(), this);
-			Call(PSF_Stuck);
+			Call(C4DefScriptHost::CB_Stuck);
 		}
 	return true;
 }
@@ -1877,7 +1878,7 @@ bool C4Object::ActivateMenu(int32_t iMenu, int32_t iMenuSelect,
 		// No target specified: use own container as target
 		if (!pTarget) if (!(pTarget = Contained)) break;
 		// Opening contents menu blocked by RejectContents
-		if (pTarget->Call(PSF_RejectContents)) return false;
+		if (pTarget->Call(C4DefScriptHost::CB_RejectContents)) return false;
 		// Create symbol
 		fctSymbol.Create(C4SymbolSize, C4SymbolSize);
 		pTarget->Def->Draw(fctSymbol, false, pTarget->Color, pTarget);
@@ -1920,7 +1921,7 @@ bool C4Object::ActivateMenu(int32_t iMenu, int32_t iMenuSelect,
 		// No target specified
 		if (!pTarget) break;
 		// Opening contents menu blocked by RejectContents
-		if (pTarget->Call(PSF_RejectContents)) return false;
+		if (pTarget->Call(C4DefScriptHost::CB_RejectContents)) return false;
 		// Create symbol & init
 		fctSymbol.Create(C4SymbolSize, C4SymbolSize);
 		pTarget->Def->Draw(fctSymbol, false, pTarget->Color, pTarget);
@@ -2200,6 +2201,14 @@ C4Value C4Object::Call(const char *szFunctionCall, const C4AulParSet &pPars, boo
 	return Def->Script.ObjectCall(this, this, szFunctionCall, pPars, fPassError, convertNilToIntBool);
 }
 
+C4Value C4Object::Call(const C4DefScriptHost::Callback callback, const C4AulParSet &pPars, bool fPassError, bool convertNilToIntBool)
+{
+	if (!Status || !Def) return C4VNull;
+	C4AulScriptFunc *const pFn{Def->Script.Callbacks[callback]};
+	if (!pFn) return C4VNull;
+	return pFn->Exec(this, pPars, fPassError, true, convertNilToIntBool);
+}
+
 bool C4Object::SetPhase(int32_t iPhase)
 {
 	if (Action.Act <= ActIdle) return false;
@@ -2900,7 +2909,7 @@ void C4Object::DenumeratePointers()
 		pCom->DenumeratePointers();
 
 	// effects
-	if (pEffects) pEffects->DenumeratePointers();
+	if (pEffects) pEffects->DenumeratePointers(this);
 
 	// gfx overlays
 	if (pGfxOverlay)
@@ -5682,11 +5691,11 @@ bool C4Object::Collect(C4Object *pObj)
 	// Cancel attach (hacky)
 	ObjectComCancelAttach(pObj);
 	// Container Collection call
-	Call(PSF_Collection, {C4VObj(pObj)});
+	Call(C4DefScriptHost::CB_Collection, {C4VObj(pObj)});
 	// Object Hit call
-	if (pObj->Status && pObj->OCF & OCF_HitSpeed1) pObj->Call(PSF_Hit);
-	if (pObj->Status && pObj->OCF & OCF_HitSpeed2) pObj->Call(PSF_Hit2);
-	if (pObj->Status && pObj->OCF & OCF_HitSpeed3) pObj->Call(PSF_Hit3);
+	if (pObj->Status && pObj->OCF & OCF_HitSpeed1) pObj->Call(C4DefScriptHost::CB_Hit);
+	if (pObj->Status && pObj->OCF & OCF_HitSpeed2) pObj->Call(C4DefScriptHost::CB_Hit2);
+	if (pObj->Status && pObj->OCF & OCF_HitSpeed3) pObj->Call(C4DefScriptHost::CB_Hit3);
 	// post-copy the motion of the new container
 	if (pObj->Contained == this) pObj->CopyMotion(this);
 	// done, success
@@ -27,6 +27,7 @@
 #include "C4ObjectInfo.h"
 #include "C4Particles.h"
 #include "C4Player.h"
+#include "C4ScriptHost.h"
 #include "C4Sector.h"
 #include "C4Value.h"
 #include "C4ValueList.h"
@@ -182,6 +183,7 @@ public:
 	std::array<int32_t, C4MaxMaterial> MaterialContents; // SyncClearance-NoSave //
 	C4DefGraphics *pGraphics; // currently set object graphics
 	C4Effect *pEffects; // linked list of effects
+	C4EffectListState EffectListState; // timer schedule and name index of pEffects
 	C4ParticleList FrontParticles, BackParticles; // lists of object local particles
 
 	bool PhysicalTemporary; // physical temporary counter
@@ -238,6 +240,7 @@ public:
 
 	bool CallControl(C4Player *pPlr, uint8_t byCom, const C4AulParSet &pPars = C4AulParSet{});
 	C4Value Call(const char *szFunctionCall, const C4AulParSet &pPars = C4AulParSet{}, bool fPassError = false, bool convertNilToIntBool = true);
+	C4Value Call(C4DefScriptHost::Callback callback, const C4AulParSet &pPars = C4AulParSet{}, bool fPassError = false, bool convertNilToIntBool = true); // pre-resolved engine callback
 
 	bool ContainedControl(uint8_t byCom);
 
@@ -94,6 +94,7 @@ const C4PktHandlingData PktHandlingData[] =
 	// C4GameControlNetwork (network thread)
 	{ PID_Control,            PC_Network, "Control",                     false, true,  PH_C4GameControlNetwork, PKT_UNPACK(C4GameControlPacket) },
 	{ PID_ControlReq,         PC_Network, "Control Request",             false, true,  PH_C4GameControlNetwork, PKT_UNPACK(C4PacketControlReq) },
+	{ PID_ControlBatch,       PC_Network, "Control Batch",               false, true,  PH_C4GameControlNetwork, PKT_UNPACK(C4PacketControlBatch) },
 	//                       main thread
 	{ PID_ControlPkt,         PC_Network, "Control Paket",               false, false, PH_C4GameControlNetwork, PKT_UNPACK(C4PacketControlPkt) },
 	{ PID_ExecSyncCtrl,       PC_Network, "Execute Sync Control",        false, false, PH_C4GameControlNetwork, PKT_UNPACK(C4PacketExecSyncCtrl) },
@@ -140,6 +140,7 @@ enum C4PacketType
 	PID_ControlReq   = 0x41,
 	PID_ControlPkt   = 0x42,
 	PID_ExecSyncCtrl = 0x43,
+	PID_ControlBatch = 0x44,
 
 	// *** control
 	CID_First = 0x80,
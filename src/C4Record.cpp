@@ -23,6 +23,7 @@
 #include <C4Console.h>
 #include <C4PlayerInfo.h>
 #include <C4GameSave.h>
+#include <C4GameVersion.h>
 #include <C4Log.h>
 #include <C4Wrappers.h>
 #include <C4Player.h>
@@ -405,6 +406,13 @@ bool C4Playback::Open(C4Group &rGrp)
 	}
 	else
 	{
+		// binary control is packed since C4RecordPackedCtrlBuild
+		const auto &ver = Game.C4S.Head.C4XVer;
+		if (CompareVersion(ver[0], ver[1], ver[2], ver[3], std::max(ver[4], 1), 4, 9, 11, 0, C4RecordPackedCtrlBuild) < 0)
+		{
+			LogFatalNTr(std::format("Record: Binary records of engine builds before [{}] are not supported.", C4RecordPackedCtrlBuild));
+			return false;
+		}
 		// open group? Then do some sequential reading for large files
 		// Can't do this when a dump is forced, because the dump needs all data
 		// Also can't do this when stripping is desired
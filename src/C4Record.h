@@ -53,6 +53,9 @@ public:
 	void Clear();
 };
 
+// first engine build writing packed control packets; binary records of older builds can't be read
+constexpr int32_t C4RecordPackedCtrlBuild = 363;
+
 enum C4RecordChunkType // record file chunk type
 {
 	RCT_Ctrl    = 0x00, // control
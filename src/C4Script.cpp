@@ -5121,8 +5121,8 @@ static bool FnFightWith(C4AulContext *ctx, C4Object *pTarget, C4Object *pClonk)
 	// check OCF
 	if (~(pTarget->OCF & pClonk->OCF) & OCF_FightReady) return false;
 	// RejectFight callback
-	if (pTarget->Call(PSF_RejectFight, {C4VObj(pTarget)}, true).getBool()) return false;
-	if (pClonk->Call(PSF_RejectFight, {C4VObj(pClonk)}, true).getBool()) return false;
+	if (pTarget->Call(C4DefScriptHost::CB_RejectFight, {C4VObj(pTarget)}, true).getBool()) return false;
+	if (pClonk->Call(C4DefScriptHost::CB_RejectFight, {C4VObj(pClonk)}, true).getBool()) return false;
 	// begin fighting
 	ObjectActionFight(pClonk, pTarget);
 	ObjectActionFight(pTarget, pClonk);
@@ -5477,7 +5477,7 @@ static C4Value FnGetEffect(C4AulContext *ctx, C4String *psEffectName, C4Object *
 	case 3: return C4VInt(pEffect->iIntervall);     // 3: timer intervall
 	case 4: return C4VObj(pEffect->pCommandTarget); // 4: command target
 	case 5: return C4VID(pEffect->idCommandTarget); // 5: command target ID
-	case 6: return C4VInt(pEffect->iTime);          // 6: effect time
+	case 6: return C4VInt(pEffect->GetTime());      // 6: effect time
 	}
 	// invalid data queried
 	return C4VNull;
@@ -5525,13 +5525,13 @@ static bool FnChangeEffect(C4AulContext *ctx, C4String *psEffectName, C4Object *
 	// effect found?
 	if (!pEffect) return false;
 	// set new name
-	SCopy(szNewEffect, pEffect->Name, C4MaxName);
+	pEffect->SetName(szNewEffect, C4MaxName);
 	pEffect->ReAssignCallbackFunctions();
 	// set new timer
 	if (iNewTimer >= 0)
 	{
 		pEffect->iIntervall = iNewTimer;
-		pEffect->iTime = 0;
+		pEffect->SetTime(0);
 	}
 	// done, success
 	return true;
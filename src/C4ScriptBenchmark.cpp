@@ -0,0 +1,202 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// headless runner for C4Script benchmarks
+
+#include <C4Include.h>
+#include <C4ScriptBenchmark.h>
+
+#include <C4Application.h>
+#include <C4Aul.h>
+#include <C4Effects.h>
+#include <C4Game.h>
+#include <C4Wrappers.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#ifdef SCRIPTBENCH_ALLOCATIONS
+
+namespace
+{
+	// counts heap allocations of the thread; non-atomic, because only the difference on the main thread is of interest
+	thread_local std::uint64_t AllocationCount{0};
+}
+
+void *operator new(const std::size_t size)
+{
+	++AllocationCount;
+	if (void *const ptr{std::malloc(std::max<std::size_t>(size, 1))}) return ptr;
+	throw std::bad_alloc{};
+}
+
+void operator delete(void *const ptr) noexcept
+{
+	std::free(ptr);
+}
+
+#endif
+
+C4ScriptBenchmark::C4ScriptBenchmark(std::string mask, const std::int32_t iterations)
+	: mask{std::move(mask)}, iterations{std::max(iterations, 1)}
+{
+}
+
+std::optional<std::uint64_t> C4ScriptBenchmark::GetAllocationCount()
+{
+#ifdef SCRIPTBENCH_ALLOCATIONS
+	return AllocationCount;
+#else
+	return {};
+#endif
+}
+
+bool C4ScriptBenchmark::Run()
+{
+	const auto logger = Application.LogSystem.CreateLoggerWithDifferentName(Config.Logging.AulProfiler, "ScriptBenchmark");
+	if (!Init(*logger)) return false;
+	// before collecting the functions, because relinking recreates them
+	RunLink(*logger);
+
+	// collect benchmarks: global functions first, then definition-local ones
+	std::vector<C4AulScriptFunc *> funcs;
+	for (C4AulFunc *func{Game.ScriptEngine.GetFirstFunc()}; func; func = Game.ScriptEngine.GetNextFunc(func))
+		if (C4AulScriptFunc *const sfunc{func->SFunc()}; sfunc && WildcardMatch(mask.c_str(), sfunc->Name))
+			funcs.push_back(sfunc);
+
+	C4Def *def;
+	for (std::size_t i{0}; (def = Game.Defs.GetDef(i)); ++i)
+	{
+		C4AulScriptFunc *sfunc;
+		for (std::int32_t j{0}; (sfunc = def->Script.GetSFunc(j)); ++j)
+			if (WildcardMatch(mask.c_str(), sfunc->Name))
+				funcs.push_back(sfunc);
+	}
+
+	if (funcs.empty())
+	{
+		logger->error("No script functions matching {} found", mask);
+		return false;
+	}
+
+	logger->info("Running {} script benchmarks with {} iterations", funcs.size(), iterations);
+	logger->info("{:>14}\t{:>12}\t{}", "ns/op", "allocs/op", "function");
+
+	bool success{true};
+	for (C4AulScriptFunc *const func : funcs)
+		success = RunFunc(*logger, *func) && success;
+
+	return success;
+}
+
+bool C4ScriptBenchmark::Init(spdlog::logger &logger)
+{
+	if (!Game.InitScriptEngine()) return false;
+
+	// scripts only; no graphics or sounds needed
+	for (const auto &filename : Game.DefinitionFilenames)
+	{
+		Game.Defs.Load(filename.c_str(), C4D_Load_Script, Config.General.LanguageEx, nullptr, true);
+		if (Game.Defs.LoadFailure)
+		{
+			logger.error("Could not load definitions from {}", filename);
+			return false;
+		}
+	}
+	Game.Defs.SortByID();
+
+	Game.LinkScriptEngine();
+	return true;
+}
+
+void C4ScriptBenchmark::RunLink(spdlog::logger &logger)
+{
+	using Clock = std::chrono::steady_clock;
+
+	const auto measure = []
+	{
+		const auto start = Clock::now();
+		for (std::int32_t i{0}; i < LinkIterations; ++i)
+			Game.ScriptEngine.ReLink(&Game.Defs);
+		return std::chrono::duration<double, std::milli>(Clock::now() - start).count() / LinkIterations;
+	};
+
+	// startup time of the scripts: cold parses all byte code, warm restores it from the code cache
+	const bool codeCache{Config.Developer.ScriptBytecodeCache};
+	Config.Developer.ScriptBytecodeCache = false;
+	const double cold{measure()};
+	Config.Developer.ScriptBytecodeCache = true;
+	// make sure the cache file exists
+	Game.ScriptEngine.ReLink(&Game.Defs);
+	const double warm{measure()};
+	Config.Developer.ScriptBytecodeCache = codeCache;
+
+	logger.info("Linking scripts: {:.2f} ms with a cold code cache, {:.2f} ms with a warm code cache", cold, warm);
+}
+
+bool C4ScriptBenchmark::RunFunc(spdlog::logger &logger, C4AulScriptFunc &func)
+{
+	using Clock = std::chrono::steady_clock;
+
+	const std::string name{func.GetFullName()};
+	try
+	{
+		// warm up caches and lazily initialized state
+		RunFrame(func);
+
+		const std::optional<std::uint64_t> allocations{GetAllocationCount()};
+		const auto start = Clock::now();
+		for (std::int32_t i{0}; i < iterations; ++i)
+			RunFrame(func);
+		const auto duration = Clock::now() - start;
+
+		ClearEffects();
+
+		const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+		if (allocations)
+			logger.info("{:14.1f}\t{:12.2f}\t{}", static_cast<double>(ns) / iterations, static_cast<double>(*GetAllocationCount() - *allocations) / iterations, name);
+		else
+			logger.info("{:14.1f}\t{:>12}\t{}", static_cast<double>(ns) / iterations, "-", name);
+		return true;
+	}
+	catch (const C4AulError &e)
+	{
+		e.show();
+		logger.error("Benchmark {} failed", name);
+		ClearEffects();
+		return false;
+	}
+}
+
+void C4ScriptBenchmark::RunFrame(C4AulScriptFunc &func)
+{
+	func.Exec(nullptr, {}, true);
+	// global effects are executed after every call, like once per frame in C4Game::Execute
+	if (Game.pGlobalEffects) Game.pGlobalEffects->Execute(nullptr);
+}
+
+void C4ScriptBenchmark::ClearEffects()
+{
+	// don't let effects of one benchmark slow down the next one
+	if (!Game.pGlobalEffects) return;
+	Game.pGlobalEffects->ClearAll(nullptr, C4FxCall_RemoveClear);
+	// dead effects are deleted on execution
+	if (Game.pGlobalEffects) Game.pGlobalEffects->Execute(nullptr);
+}
@@ -0,0 +1,58 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// headless runner for C4Script benchmarks
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace spdlog { class logger; }
+
+class C4AulScriptFunc;
+
+// Loads System.c4g and the definitions given on the command line into the script engine, without landscape, players
+// or graphics, and runs every script function matching a mask (global or definition-local) a fixed number of times.
+// Reports time per call, and heap allocations per call if built with SCRIPTBENCH_ALLOCATIONS, so interpreter performance
+// can be tracked outside of a running game.
+// Before that, the time needed to link all scripts is measured with a cold and with a warm byte code cache.
+// Each call counts as one frame: global effects that the benchmark added are executed after it.
+// Started by the /scriptbench[:mask] command line parameter; see the scriptbench target.
+class C4ScriptBenchmark
+{
+public:
+	static constexpr const char *DefaultMask = "Bench*";
+	static constexpr std::int32_t DefaultIterations = 1000;
+
+	C4ScriptBenchmark(std::string mask, std::int32_t iterations);
+
+	bool Run(); // returns false if loading failed, no benchmark was found or a benchmark raised an error
+
+	static std::optional<std::uint64_t> GetAllocationCount(); // number of operator new calls on the current thread; only counted with SCRIPTBENCH_ALLOCATIONS
+
+private:
+	static constexpr std::int32_t LinkIterations = 10;
+
+	std::string mask;
+	std::int32_t iterations;
+
+	bool Init(spdlog::logger &logger);
+	void RunLink(spdlog::logger &logger); // compares relinking all scripts with and without the byte code cache
+	bool RunFunc(spdlog::logger &logger, C4AulScriptFunc &func);
+	void RunFrame(C4AulScriptFunc &func); // one benchmark call, followed by one execution of the global effects
+	void ClearEffects();
+};
@@ -24,6 +24,9 @@
 #include <C4Object.h>
 #include <C4Wrappers.h>
 
+#include <algorithm>
+#include <iterator>
+
 // C4ScriptHost
 
 C4ScriptHost::C4ScriptHost() { Default(); }
@@ -172,10 +175,39 @@ const char *C4ScriptHost::GetControlDesc(const char *szFunctionFormat, int32_t i
 
 // C4DefScriptHost
 
+namespace
+{
+	// function names of C4DefScriptHost::Callback
+	constexpr const char *CallbackNames[]
+	{
+		PSF_RejectFight,
+		PSF_QueryCatchBlow,
+		PSF_CatchBlow,
+		PSF_Hit,
+		PSF_Hit2,
+		PSF_Hit3,
+		"~ContactLeft",
+		"~ContactRight",
+		"~ContactTop",
+		"~ContactBottom",
+		PSF_Collection,
+		PSF_Collection2,
+		PSF_RejectCollection,
+		PSF_RejectContents,
+		PSF_Entrance,
+		PSF_Departure,
+		PSF_Damage,
+		PSF_Stuck
+	};
+
+	static_assert(std::size(CallbackNames) == C4DefScriptHost::CB_Count);
+}
+
 void C4DefScriptHost::Default()
 {
 	C4ScriptHost::Default();
 	SFn_CalcValue = SFn_SellTo = SFn_ControlTransfer = SFn_CustomComponents = nullptr;
+	std::ranges::fill(Callbacks, nullptr);
 	ControlMethod[0] = ControlMethod[1] = ContainedControlMethod[0] = ContainedControlMethod[1] = ActivationControlMethod[0] = ActivationControlMethod[1] = 0;
 }
 
@@ -188,6 +220,9 @@ void C4DefScriptHost::AfterLink()
 	SFn_SellTo           = GetSFunc(PSF_SellTo,              AA_PROTECTED);
 	SFn_ControlTransfer  = GetSFunc(PSF_ControlTransfer,     AA_PROTECTED);
 	SFn_CustomComponents = GetSFunc(PSF_GetCustomComponents, AA_PROTECTED);
+	// same lookup as C4Object::Call (all callbacks are failsafe)
+	for (std::size_t i = 0; i < CB_Count; ++i)
+		Callbacks[i] = GetSFunc(CallbackNames[i], AA_PRIVATE);
 	if (Def)
 	{
 		C4AulAccess CallAccess = AA_PRIVATE;
@@ -78,6 +78,32 @@ public:
 	C4AulScriptFunc *SFn_ControlTransfer; // object par(0) tries to get to par(1)/par(2)
 	C4AulScriptFunc *SFn_CustomComponents; // PSF_GetCustomComponents
 	int32_t ControlMethod[2], ContainedControlMethod[2], ActivationControlMethod[2];
+
+	// frequent engine callbacks; resolved in AfterLink, so C4Object::Call doesn't need to look them up by name
+	enum Callback
+	{
+		CB_RejectFight,
+		CB_QueryCatchBlow,
+		CB_CatchBlow,
+		CB_Hit,
+		CB_Hit2,
+		CB_Hit3,
+		CB_ContactLeft,
+		CB_ContactRight,
+		CB_ContactTop,
+		CB_ContactBottom,
+		CB_Collection,
+		CB_Collection2,
+		CB_RejectCollection,
+		CB_RejectContents,
+		CB_Entrance,
+		CB_Departure,
+		CB_Damage,
+		CB_Stuck,
+		CB_Count
+	};
+
+	C4AulScriptFunc *Callbacks[CB_Count];
 };
 
 // script host for scenario scripts
@@ -30,6 +30,7 @@ C4String::C4String(StdStrBuf &&strString, C4StringTable *pnTable)
 {
 	// take string
 	Data.Take(strString);
+	Capacity = Data.getSize();
 	// reg
 	Reg(pnTable);
 }
@@ -39,6 +40,7 @@ C4String::C4String(const char *strString, C4StringTable *pnTable)
 {
 	// copy string
 	Data = strString;
+	Capacity = Data.getSize();
 	// reg
 	Reg(pnTable);
 }
@@ -50,6 +52,24 @@ C4String::~C4String()
 	if (pTable) UnReg();
 }
 
+void C4String::Append(const StdStrBuf &string)
+{
+	if (!string.getLength()) return;
+
+	const std::size_t length{Data.getLength()};
+	const std::size_t size{length + string.getLength() + 1};
+
+	auto *data = static_cast<char *>(Data.GrabPointer());
+	if (size > Capacity)
+	{
+		Capacity = (std::max)(size, 2 * Capacity);
+		data = static_cast<char *>(realloc(data, Capacity));
+	}
+	std::memcpy(data + length, string.getData(), string.getLength());
+	data[size - 1] = '\0';
+	Data.Take(data, size - 1);
+}
+
 void C4String::IncRef()
 {
 	++iRefCnt;
@@ -34,7 +34,11 @@ public:
 	void IncRef();
 	void DecRef();
 
+	// append in place; the buffer grows geometrically, so building a string piece by piece stays linear
+	void Append(const StdStrBuf &string);
+
 	StdStrBuf Data; // string data
+	std::size_t Capacity; // allocated size of Data
 	int iRefCnt; // reference count on string (by C4Value)
 	bool Hold; // string stays hold when RefCnt reaches 0 (for in-script strings)
 
@@ -16,8 +16,10 @@
 #include "C4ThreadPool.h"
 
 #ifdef _WIN32
+#include <algorithm>
 #include <format>
 #include <limits>
+#include <thread>
 
 #include <threadpoolapiset.h>
 #endif
@@ -213,7 +215,7 @@ void C4ThreadPool::Io::Callback(const PTP_CALLBACK_INSTANCE instance, void *cons
 	}
 }
 
-C4ThreadPool::C4ThreadPool(const std::uint32_t minimum, const std::uint32_t maximum)
+C4ThreadPool::C4ThreadPool(const std::uint32_t minimum, const std::uint32_t maximum) : maximumThreadCount{maximum}
 {
 	MapHResultError([minimum, maximum, this]
 	{
@@ -234,6 +236,12 @@ C4ThreadPool::~C4ThreadPool()
 {
 }
 
+std::uint32_t C4ThreadPool::GetThreadCount() const noexcept
+{
+	// the process default pool grows as needed
+	return maximumThreadCount ? maximumThreadCount : std::max(std::thread::hardware_concurrency(), 1u);
+}
+
 void C4ThreadPool::SubmitCallback(const PTP_SIMPLE_CALLBACK callback, void *const data)
 {
 	if (!TrySubmitThreadpoolCallback(callback, data, GetCallbackEnvironment()))
@@ -268,6 +276,11 @@ C4ThreadPool::~C4ThreadPool()
 	}
 }
 
+std::uint32_t C4ThreadPool::GetThreadCount() const noexcept
+{
+	return static_cast<std::uint32_t>(threads.size());
+}
+
 void C4ThreadPool::ThreadProc()
 {
 	for (;;)
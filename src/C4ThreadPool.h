@@ -222,6 +222,8 @@ public:
 	C4ThreadPool &operator=(C4ThreadPool &&) = delete;
 
 public:
+	std::uint32_t GetThreadCount() const noexcept; // number of callbacks that can run at the same time
+
 #ifdef _WIN32
 	template<typename T>
 	void SubmitCallback(T &&callback)
@@ -315,6 +317,7 @@ public:
 private:
 #ifdef _WIN32
 	CallbackEnvironment callbackEnvironment;
+	std::uint32_t maximumThreadCount{0}; // 0 for the process default pool
 	winrt::handle_type<ThreadPoolTraits> pool;
 	winrt::handle_type<ThreadPoolCleanupTraits> cleanupGroup;
 #else
@@ -176,6 +176,7 @@ public:
 	C4ValueHash *_getMap()    const { return Data.Map; }
 	C4Value *_getRef()        const { return Data.Ref; }
 	std::intptr_t _getRaw()   const { return Data.Raw; }
+	C4V_Type _getType()       const { return Type; } // without following references
 
 	// Template versions
 	template <typename T> inline T Get() { return C4ValueConv<T>::FromC4V(*this); }
@@ -17,8 +17,9 @@
 #include "C4ValueHash.h"
 #include "C4StringTable.h"
 
+#include <algorithm>
+#include <bit>
 #include <optional>
-#include <stdexcept>
 
 C4ValueHash::C4ValueHash() { }
 
@@ -30,6 +31,10 @@ C4ValueHash::C4ValueHash(const C4ValueHash &other)
 C4ValueHash::~C4ValueHash()
 {
 	clear();
+	while (firstIterator)
+	{
+		firstIterator->detach();
+	}
 }
 
 void C4ValueHash::CompileFunc(StdCompiler *pComp)
@@ -48,50 +53,67 @@ void C4ValueHash::DenumeratePointers()
 
 void C4ValueHash::removeValue(C4Value *value)
 {
-	const auto erase = [this](const auto &it)
-	{
-		keyOrder.erase(it->second.keyOrderIterator);
-		map.erase(it);
-	};
-	bool found = false;
-	auto keyIt = map.end();
-	for (auto it = map.begin(); it != map.end(); )
+	for (std::size_t i = 0; i < entries.size(); ++i)
 	{
-		if (&it->first == value)
+		auto &entry = entries[i];
+		if (entry.key == value)
 		{
-			keyIt = it;
-			emptyValues.push_front(it->second.value);
+			// the key is being cleared, e.g. because the object it refers to has been deleted
+			emptyValues.push_back(entry.value);
+			delete entry.key;
+			removeEntry(i);
+			return;
 		}
-		else if (it->second.value == value)
+		else if (entry.value == value)
 		{
-			erase(it++);
-			found = true;
-			continue;
+			emptyValues.push_back(value);
+			delete entry.key;
+			removeEntry(i);
+			return;
 		}
-		++it;
 	}
-	if (found) emptyValues.push_front(value);
-	if (keyIt != map.end()) erase(keyIt);
 }
 
 bool C4ValueHash::contains(const C4Value &key) const
 {
-	return map.find(key) != map.end();
+	return find(key, std::hash<C4Value>{}(key)) != npos;
 }
 
 void C4ValueHash::clear()
 {
-	for (auto &[key, value] : map) delete value.value;
-	map.clear();
+	for (const auto &entry : entries)
+	{
+		if (entry.key)
+		{
+			delete entry.key;
+			delete entry.value;
+		}
+	}
+	entries.clear();
+	slots.clear();
+	liveCount = 0;
 	for (auto &value : emptyValues) delete value;
 	emptyValues.clear();
+
+	for (auto *it = firstIterator; it; it = it->nextIterator)
+	{
+		if (it->index != npos) it->index = 0;
+	}
 }
 
 C4ValueHash &C4ValueHash::operator=(const C4ValueHash &other)
 {
-	for (const auto key : other.keyOrder)
+	if ((entries.size() + other.size()) * 2 > slots.size())
 	{
-		(*this)[*key].Set(*other.map.at(*key).value);
+		rehash(liveCount + other.size());
+	}
+
+	for (const auto &entry : other.entries)
+	{
+		if (entry.key)
+		{
+			(*this)[*entry.key].Set(*entry.value);
+		}
 	}
 	return *this;
 }
@@ -100,9 +122,12 @@ bool C4ValueHash::operator==(const C4ValueHash &other) const
 {
 	if (other.size() != size()) return false;
 
-	for (const auto &it : map)
+	for (const auto &entry : entries)
 	{
-		if (!other.contains(it.first) || other[it.first] != *it.second.value)
+		if (!entry.key) continue;
+
+		const auto index = other.find(*entry.key, entry.hash);
+		if (index == npos || *other.entries[index].value != *entry.value)
 			return false;
 	}
 
@@ -116,78 +141,194 @@ bool C4ValueHash::hasIndex(const C4Value &key) const
 
 C4Value &C4ValueHash::operator[](const C4Value &key)
 {
-	try
+	const auto hash = std::hash<C4Value>{}(key);
+	if (const auto index = find(key, hash); index != npos)
 	{
-		return *map.at(key).value;
+		return *entries[index].value;
 	}
-	catch (const std::out_of_range &)
+
+	// removed entries keep their slot until the next rehash, so they count towards the load factor
+	if ((entries.size() + 1) * 2 > slots.size())
 	{
-		C4Value *value;
-		if (emptyValues.empty()) value = C4Value::OfMap(this);
-		else
-		{
-			value = emptyValues.front();
-			emptyValues.pop_front();
-		}
+		rehash(liveCount + 1);
+	}
 
-		const auto &inserted = map.emplace(std::piecewise_construct, std::forward_as_tuple(key, this), std::forward_as_tuple(MapEntry{value, {}})).first;
-		inserted->second.keyOrderIterator = keyOrder.insert(keyOrder.end(), &inserted->first);
-		return *value;
+	C4Value *value;
+	if (emptyValues.empty()) value = C4Value::OfMap(this);
+	else
+	{
+		value = emptyValues.back();
+		emptyValues.pop_back();
 	}
+
+	entries.push_back({new C4Value(key, this), value, hash});
+	insertSlot(hash, entries.size() - 1);
+	++liveCount;
+	return *value;
 }
 
 const C4Value &C4ValueHash::operator[](const C4Value &key) const
 {
-	try
-	{
-		return *map.at(key).value;
-	}
-	catch (const std::out_of_range &)
+	if (const auto index = find(key, std::hash<C4Value>{}(key)); index != npos)
 	{
-		return C4VNull;
+		return *entries[index].value;
 	}
+	return C4VNull;
 }
 
 C4ValueHash::Iterator C4ValueHash::begin()
 {
-	return Iterator(this, keyOrder.begin(), keyOrder.end());
+	return Iterator(this, 0);
 }
 
 C4ValueHash::Iterator C4ValueHash::end()
 {
-	return Iterator(this, keyOrder.end(), keyOrder.end());
+	return Iterator(this, npos);
 }
 
-C4ValueHash::Iterator::Iterator(C4ValueHash *map, C4ValueHash::Iterator::iterator_type it, C4ValueHash::Iterator::iterator_type end) : it(it), end(end), map(map)
+std::size_t C4ValueHash::find(const C4Value &key, const std::size_t hash) const
 {
-	update();
+	if (slots.empty()) return npos;
+
+	const auto mask = slots.size() - 1;
+	for (auto i = hash & mask; slots[i] != EmptySlot; i = (i + 1) & mask)
+	{
+		const auto &entry = entries[slots[i] - 1];
+		if (entry.key && entry.hash == hash && entry.key->Equals(key, C4AulScriptStrict::MAXSTRICT))
+		{
+			return slots[i] - 1;
+		}
+	}
+	return npos;
 }
 
-void C4ValueHash::Iterator::update()
+void C4ValueHash::insertSlot(const std::size_t hash, const std::size_t entryIndex)
 {
-	if (it != end)
+	const auto mask = slots.size() - 1;
+	auto i = hash & mask;
+	while (slots[i] != EmptySlot)
 	{
-		current.emplace(**it, (*map)[**it]);
+		i = (i + 1) & mask;
 	}
-	else
+	slots[i] = static_cast<std::uint32_t>(entryIndex + 1);
+}
+
+void C4ValueHash::rehash(const std::size_t minLiveCount)
+{
+	// compact removed entries away, keeping the insertion order
+	if (liveCount != entries.size())
 	{
+		for (auto *it = firstIterator; it; it = it->nextIterator)
+		{
+			if (it->index == npos) continue;
+
+			const auto end = std::min(it->index, entries.size());
+			it->index = static_cast<std::size_t>(std::count_if(entries.begin(), entries.begin() + end, [](const Entry &entry) { return entry.key != nullptr; }));
+		}
+
+		std::erase_if(entries, [](const Entry &entry) { return entry.key == nullptr; });
+	}
+
+	entries.reserve(minLiveCount);
+	slots.assign(std::max(MinSlotCount, std::bit_ceil(minLiveCount * 2)), EmptySlot);
+	for (std::size_t i = 0; i < entries.size(); ++i)
+	{
+		insertSlot(entries[i].hash, i);
+	}
+}
+
+void C4ValueHash::removeEntry(const std::size_t entryIndex)
+{
+	// the slot keeps pointing to the removed entry so that probe sequences stay intact
+	entries[entryIndex].key = nullptr;
+	entries[entryIndex].value = nullptr;
+	--liveCount;
+}
+
+C4ValueHash::Iterator::Iterator(C4ValueHash *map, const std::size_t index) : map(map), index(index)
+{
+	attach();
+}
+
+C4ValueHash::Iterator::Iterator(const C4ValueHash::Iterator &other) : map(other.map), index(other.index)
+{
+	attach();
+}
+
+C4ValueHash::Iterator::~Iterator()
+{
+	detach();
+}
+
+C4ValueHash::Iterator &C4ValueHash::Iterator::operator=(const C4ValueHash::Iterator &other)
+{
+	if (this != &other)
+	{
+		detach();
+		map = other.map;
+		index = other.index;
 		current.reset();
+		attach();
+	}
+	return *this;
+}
+
+void C4ValueHash::Iterator::attach()
+{
+	if (!map) return;
+
+	prevIterator = nullptr;
+	nextIterator = map->firstIterator;
+	if (nextIterator) nextIterator->prevIterator = this;
+	map->firstIterator = this;
+}
+
+void C4ValueHash::Iterator::detach()
+{
+	if (!map) return;
+
+	if (prevIterator) prevIterator->nextIterator = nextIterator;
+	else map->firstIterator = nextIterator;
+	if (nextIterator) nextIterator->prevIterator = prevIterator;
+	prevIterator = nextIterator = nullptr;
+	map = nullptr;
+}
+
+std::size_t C4ValueHash::Iterator::position() const
+{
+	const auto &entries = map->entries;
+	auto i = index;
+	while (i < entries.size() && !entries[i].key)
+	{
+		++i;
+	}
+	return std::min(i, entries.size());
+}
+
+void C4ValueHash::Iterator::skipRemoved()
+{
+	if (index != npos)
+	{
+		index = position();
 	}
 }
 
 C4ValueHash::Iterator &C4ValueHash::Iterator::operator++()
 {
-	++it;
-	update();
+	skipRemoved();
+	++index;
 	return *this;
 }
 
 C4ValueHash::Iterator::pair_type &C4ValueHash::Iterator::operator*()
 {
+	skipRemoved();
+	const auto &entry = map->entries[index];
+	current.emplace(*entry.key, *entry.value);
 	return *current;
 }
 
 bool C4ValueHash::Iterator::operator==(const C4ValueHash::Iterator &other) const
 {
-	return it == other.it;
+	return position() == other.position();
 }
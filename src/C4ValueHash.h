@@ -18,11 +18,15 @@
 #include "C4Value.h"
 #include "C4ValueStandardRefCountedContainer.h"
 
-#include <unordered_map>
-#include <forward_list>
-#include <list>
-#include <memory>
-
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+// Insertion-ordered open-addressing hash map.
+// Entries are stored densely in insertion order (we need a defined order for network sync);
+// removed entries are left as tombstones until the next rehash compacts them away.
+// The index table maps hash slots to entry positions using linear probing.
 class C4ValueHash : public C4ValueStandardRefCountedContainer<C4ValueHash>
 {
 public:
@@ -30,41 +34,58 @@ public:
 	using mapped_type = C4Value;
 
 private:
-	struct MapEntry
+	struct Entry
 	{
+		// keys and values are allocated separately, because C4Values referencing them need stable addresses
+		// key == nullptr marks a removed entry
+		C4Value *key;
 		C4Value *value;
-		std::list<const C4Value *>::iterator keyOrderIterator;
-	};
-
-	struct KeyEqual
-	{
-		bool operator()(const C4Value &lhs, const C4Value &rhs) const noexcept { return lhs.Equals(rhs, C4AulScriptStrict::MAXSTRICT); }
+		std::size_t hash;
 	};
 
-	std::unordered_map<key_type, MapEntry, std::hash<key_type>, KeyEqual> map;
-	std::forward_list<C4Value *> emptyValues;
+	static constexpr std::uint32_t EmptySlot = 0;
+	static constexpr std::size_t MinSlotCount = 8;
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
 
-	// we need a defined order for network sync
-	std::list<const C4Value *> keyOrder;
+	std::vector<Entry> entries;
+	// entry position + 1, EmptySlot if unused
+	std::vector<std::uint32_t> slots;
+	std::size_t liveCount = 0;
+	std::vector<C4Value *> emptyValues;
 
 public:
+	class Iterator;
+
+private:
+	// iterators which have to be adjusted when entries are compacted
+	Iterator *firstIterator = nullptr;
 
+public:
 	class Iterator
 	{
 		using pair_type = std::pair<const C4Value &, C4Value &>;
-		using iterator_type = decltype(keyOrder.begin());
-		iterator_type it, end;
 		C4ValueHash *map;
+		std::size_t index;
 		std::optional<pair_type> current;
 
-		void update();
+		Iterator *prevIterator = nullptr, *nextIterator = nullptr;
+
+		void attach();
+		void detach();
+		void skipRemoved();
+		std::size_t position() const;
 
 	public:
-		Iterator(C4ValueHash *map, iterator_type it, iterator_type end);
+		Iterator(C4ValueHash *map, std::size_t index);
+		Iterator(const Iterator &other);
+		~Iterator();
 
+		Iterator &operator=(const Iterator &other);
 		Iterator &operator++();
 		pair_type &operator*();
 		bool operator==(const Iterator &other) const;
+
+		friend class C4ValueHash;
 	};
 
 	C4ValueHash();
@@ -85,6 +106,12 @@ public:
 
 	bool contains(const C4Value &key) const;
 	void removeValue(C4Value *value);
-	auto size() const { return map.size(); }
+	auto size() const { return liveCount; }
 	void clear();
+
+private:
+	std::size_t find(const C4Value &key, std::size_t hash) const;
+	void insertSlot(std::size_t hash, std::size_t entryIndex);
+	void rehash(std::size_t minLiveCount);
+	void removeEntry(std::size_t entryIndex);
 };
@@ -21,8 +21,10 @@
 #include <C4Aul.h>
 #include <C4FindObject.h>
 
+#include <algorithm>
 #include <format>
 #include <compare>
+#include <memory>
 #include <ranges>
 
 C4ValueList::C4ValueList(const std::int32_t size)
@@ -31,17 +33,37 @@ C4ValueList::C4ValueList(const std::int32_t size)
 }
 
 C4ValueList::C4ValueList(const C4ValueList &other)
-	: values{other.values}
 {
+	Reserve(other.size);
+
+	for (const auto &value : std::span{other.Data(), static_cast<std::size_t>(other.size)})
+	{
+		new (Data() + size++) C4Value{value};
+	}
+}
+
+C4ValueList::~C4ValueList()
+{
+	Reset();
+
+	if (heapValues)
+	{
+		::operator delete(heapValues);
+	}
 }
 
 C4ValueList &C4ValueList::operator=(const C4ValueList &other)
 {
-	values.resize(other.values.size());
+	if (this == &other)
+	{
+		return *this;
+	}
+
+	SetSize(other.size);
 
-	for (std::size_t i{0}; i < values.size(); ++i)
+	for (std::int32_t i{0}; i < size; ++i)
 	{
-		values[i].Set(other.values[i]);
+		Data()[i].Set(other.Data()[i]);
 	}
 
 	return *this;
@@ -61,7 +83,33 @@ C4Value &C4ValueList::GetItem(std::int32_t index)
 		throw C4AulExecError(nullptr, "out of memory");
 	}
 
-	return values[index];
+	return Data()[index];
+}
+
+void C4ValueList::Reserve(const std::int32_t newCapacity)
+{
+	if (newCapacity <= capacity)
+	{
+		return;
+	}
+
+	auto *const newValues = static_cast<C4Value *>(::operator new(sizeof(C4Value) * newCapacity));
+	auto *const oldValues = Data();
+
+	for (std::int32_t i{0}; i < size; ++i)
+	{
+		// values may be referenced, so they have to be moved explicitly
+		oldValues[i].Move(new (newValues + i) C4Value{});
+		oldValues[i].~C4Value();
+	}
+
+	if (heapValues)
+	{
+		::operator delete(heapValues);
+	}
+
+	heapValues = newValues;
+	capacity = newCapacity;
 }
 
 void C4ValueList::SetSize(const std::int32_t size)
@@ -75,28 +123,35 @@ void C4ValueList::SetSize(const std::int32_t size)
 
 	else if (cmp == std::strong_ordering::less)
 	{
-		values.resize(size);
+		std::ranges::destroy(Data() + size, Data() + this->size);
+		this->size = size;
 		return;
 	}
 
-	std::vector<C4Value> newValues(size);
-
-	for (std::size_t i{0}; i < values.size(); ++i)
+	// grow geometrically so that appending single elements stays cheap
+	if (size > capacity)
 	{
-		values[i].Move(&newValues[i]);
+		Reserve(std::min<std::int32_t>(std::max(size, capacity * 2), MaxSize));
 	}
 
-	values = std::move(newValues);
+	std::ranges::uninitialized_value_construct(Data() + this->size, Data() + size);
+	this->size = size;
 }
 
 void C4ValueList::Reset()
 {
-	values.clear();
+	std::ranges::destroy(Data(), Data() + size);
+	size = 0;
+}
+
+bool C4ValueList::operator==(const C4ValueList &other) const
+{
+	return std::ranges::equal(Data(), Data() + size, other.Data(), other.Data() + other.size);
 }
 
 void C4ValueList::DenumeratePointers()
 {
-	std::ranges::for_each(values, &C4Value::DenumeratePointer);
+	std::ranges::for_each(Data(), Data() + size, &C4Value::DenumeratePointer);
 }
 
 void C4ValueList::CompileFunc(class StdCompiler *pComp)
@@ -120,9 +175,9 @@ void C4ValueList::CompileFunc(class StdCompiler *pComp)
 		pComp->Separator(StdCompiler::SEP_SEP);
 		this->SetSize(C4MaxVariable);
 		// First variable was misinterpreted as size
-		values[0] = C4Value{C4V_Data{size}, C4V_Any};
+		Data()[0] = C4Value{C4V_Data{size}, C4V_Any};
 		// Read remaining data
-		pComp->Value(mkArrayAdaptS(values.data() + 1, C4MaxVariable - 1, C4Value()));
+		pComp->Value(mkArrayAdaptS(Data() + 1, C4MaxVariable - 1, C4Value()));
 	}
 	else
 	{
@@ -131,11 +186,11 @@ void C4ValueList::CompileFunc(class StdCompiler *pComp)
 			// Allocate
 			this->SetSize(size);
 			// Values
-			pComp->Value(mkArrayAdaptS(values.data(), size, C4Value()));
+			pComp->Value(mkArrayAdaptS(Data(), size, C4Value()));
 		}
 		else
 		{
-			pComp->Value(mkArrayAdaptS(values.data(), size));
+			pComp->Value(mkArrayAdaptS(Data(), size));
 		}
 	}
 }
@@ -157,7 +212,7 @@ C4ValueArray *C4ValueArray::SetLength(int32_t size)
 	{
 		C4ValueArray *pNew = static_cast<C4ValueArray *>((new C4ValueArray(size))->IncRef());
 		for (std::int32_t i = 0; i < (std::min)(size, GetSize()); i++)
-			pNew->values[i].Set(values[i]);
+			pNew->Data()[i].Set(Data()[i]);
 		DecRef();
 		return pNew;
 	}
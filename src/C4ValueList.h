@@ -21,14 +21,18 @@
 #include "C4Value.h"
 #include "C4ValueStandardRefCountedContainer.h"
 
+#include <cstddef>
+#include <new>
 #include <span>
-#include <vector>
 
 class C4ValueList
 {
 public:
 	enum { MaxSize = 1000000, }; // ye shalt not create arrays larger than that!
 
+	// Lists up to this size are stored inline without a separate heap allocation
+	static constexpr std::int32_t InlineCapacity = 4;
+
 	C4ValueList() = default;
 	C4ValueList(std::int32_t size);
 	C4ValueList(const C4ValueList &other);
@@ -36,23 +40,34 @@ public:
 	template<typename T>
 	C4ValueList(const std::span<T> data)
 	{
-		values.reserve(data.size());
+		Reserve(static_cast<std::int32_t>(data.size()));
 
 		for (const auto value : data)
 		{
-			values.emplace_back(value);
+			new (Data() + size++) C4Value{value};
 		}
 	}
 
+	~C4ValueList();
+
 	C4ValueList &operator=(const C4ValueList &ValueList2);
 
 protected:
-	std::vector<C4Value> values;
+	C4Value *heapValues{nullptr};
+	std::int32_t size{0};
+	std::int32_t capacity{InlineCapacity};
+	alignas(C4Value) std::byte inlineValues[InlineCapacity * sizeof(C4Value)];
+
+	C4Value *Data() { return heapValues ? heapValues : reinterpret_cast<C4Value *>(inlineValues); }
+	const C4Value *Data() const { return heapValues ? heapValues : reinterpret_cast<const C4Value *>(inlineValues); }
+
+	// Grows the storage to hold at least the given number of values, moving references to existing values
+	void Reserve(std::int32_t newCapacity);
 
 public:
-	std::int32_t GetSize() const { return static_cast<std::int32_t>(values.size()); }
+	std::int32_t GetSize() const { return size; }
 
-	const C4Value &GetItem(const std::int32_t index) const { return Inside(index, 0, GetSize() - 1) ? values[index] : C4VNull; }
+	const C4Value &GetItem(const std::int32_t index) const { return Inside(index, 0, GetSize() - 1) ? Data()[index] : C4VNull; }
 	C4Value &GetItem(std::int32_t index);
 
 	C4Value operator[](const std::int32_t index) const { return GetItem(index); }
@@ -64,7 +79,7 @@ public:
 	void DenumeratePointers();
 
 	// comparison
-	bool operator==(const C4ValueList &other) const = default;
+	bool operator==(const C4ValueList &other) const;
 
 	// Compilation
 	void CompileFunc(class StdCompiler *pComp);
@@ -186,13 +186,9 @@ void C4ValueMapData::OnNameListChanged(const char *const *pOldNames, int32_t iOl
 		{
 			pOldData[i].Move(&pData[i]);
 		}
-		else for (j = 0; j < pNames->iSize; j++)
+		else if ((j = pNames->GetItemNr(pOldNames[i])) != -1)
 		{
-			if (SEqual(pNames->pNames[j], pOldNames[i]))
-			{
-				pOldData[i].Move(&pData[j]);
-				break; // in hope this will only break the last for...
-			}
+			pOldData[i].Move(&pData[j]);
 		}
 	}
 	// delete old data array
@@ -320,6 +316,7 @@ void C4ValueMapNames::Reset()
 	delete[] pExtra;
 	pNames = nullptr; pExtra = nullptr;
 	iSize = 0;
+	NameIndex.clear();
 }
 
 void C4ValueMapNames::Register(C4ValueMapData *pData)
@@ -380,6 +377,12 @@ void C4ValueMapNames::ChangeNameList(const char *const *pnNames, int32_t *pnExtr
 	// set new size
 	iSize = nSize;
 
+	// index new names; first occurrence wins, like a linear search would
+	NameIndex.clear();
+	NameIndex.reserve(nSize);
+	for (i = 0; i < nSize; i++)
+		NameIndex.try_emplace(pNames[i], i);
+
 	// call OnNameListChanged list for all "child" lists
 	C4ValueMapData *pAktData = pFirst;
 	while (pAktData)
@@ -437,10 +440,9 @@ int32_t C4ValueMapNames::AddName(const char *pnName, int32_t iExtra)
 	return iSize - 1;
 }
 
-int32_t C4ValueMapNames::GetItemNr(const char *strName)
+int32_t C4ValueMapNames::GetItemNr(const char *strName) const
 {
-	for (int32_t i = 0; i < iSize; i++)
-		if (SEqual(pNames[i], strName))
-			return i;
-	return -1;
+	if (!strName) return -1;
+	const auto it = NameIndex.find(strName);
+	return it != NameIndex.end() ? it->second : -1;
 }
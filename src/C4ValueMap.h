@@ -18,6 +18,9 @@
 
 #include <C4Value.h>
 
+#include <string_view>
+#include <unordered_map>
+
 // implements a list of C4Values associated with a name list.
 // the list is split in the two components (data/names) to make it possible
 // to have multiple data lists using a single name list
@@ -116,7 +119,7 @@ public:
 	// returns the nr of the given name
 	// (= nr of value in "child" data lists)
 	// returns -1 if no item with given name exists
-	int32_t GetItemNr(const char *strName);
+	int32_t GetItemNr(const char *strName) const;
 
 	void Reset();
 
@@ -124,6 +127,9 @@ private:
 	// points to first data list using this name list
 	C4ValueMapData *pFirst;
 
+	// name -> nr, for lookups by name (e.g. LocalN, obj->name); views into pNames
+	std::unordered_map<std::string_view, int32_t> NameIndex;
+
 	void Register(C4ValueMapData *pData);
 	void UnRegister(C4ValueMapData *pData);
 
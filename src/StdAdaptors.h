@@ -25,6 +25,7 @@
 #include <limits>
 #include <memory>
 #include <optional>
+#include <type_traits>
 
 // * Wrappers for C4Compiler-types
 
@@ -815,6 +816,38 @@ struct StdIntPackAdapt
 template <class T>
 StdIntPackAdapt<T> mkIntPackAdapt(T &rVal) { return StdIntPackAdapt<T>(rVal); }
 
+// Packed delta: Writes the difference to a running base value as a packed integer and advances
+// the base to the value afterwards. Sequences that change slowly (client IDs, ticks) take a byte
+// per entry. Textual compilers get the plain value.
+template <class T>
+struct StdIntPackDeltaAdapt
+{
+	StdIntPackDeltaAdapt(T &rVal, T &rBase) : rVal(rVal), rBase(rBase) {}
+
+	T &rVal, &rBase;
+
+	void CompileFunc(StdCompiler *pComp) const
+	{
+		if (pComp->hasNaming())
+		{
+			pComp->Value(rVal);
+			rBase = rVal;
+			return;
+		}
+		// wrap around instead of overflowing
+		using U = std::make_unsigned_t<T>;
+		T diff = static_cast<T>(static_cast<U>(rVal) - static_cast<U>(rBase));
+		pComp->Value(mkIntPackAdapt(diff));
+		rBase = rVal = static_cast<T>(static_cast<U>(rBase) + static_cast<U>(diff));
+	}
+
+	template <class D> inline bool operator==(const D &nValue) const { return rVal == nValue; }
+	template <class D> inline StdIntPackDeltaAdapt &operator=(const D &nValue) { rVal = nValue; rBase = rVal; return *this; }
+};
+
+template <class T>
+StdIntPackDeltaAdapt<T> mkIntPackDeltaAdapt(T &rVal, T &rBase) { return StdIntPackDeltaAdapt<T>(rVal, rBase); }
+
 template <class T>
 struct StdEnumEntry
 {
@@ -33,6 +33,7 @@
 #endif
 
 #ifndef _WIN32
+#include <algorithm>
 #include <ranges>
 #include <unordered_map>
 
@@ -42,25 +43,227 @@
 
 // *** StdSchedulerProc
 
+#ifndef _WIN32
+
+void StdSchedulerProc::OnFDClosed(const int fd)
+{
+#ifdef __linux__
+	// each number only once, so the list stays bounded if no scheduler collects it
+	CStdLock lock{&closedFDsCSec};
+	if (std::ranges::find(closedFDs, fd) == closedFDs.end())
+	{
+		closedFDs.emplace_back(fd);
+	}
+#endif
+}
+
+#endif
+
 // *** StdScheduler
 
+#ifdef __linux__
+
+StdScheduler::StdScheduler()
+{
+	epollFD = epoll_create1(EPOLL_CLOEXEC);
+	if (epollFD == -1) return;
+
+	// the unblocker is the only FD without a proc
+	epoll_event event{.events = EPOLLIN, .data = {.ptr = nullptr}};
+	if (epoll_ctl(epollFD, EPOLL_CTL_ADD, unblocker.GetFD(), &event) == -1)
+	{
+		close(epollFD);
+		epollFD = -1;
+		return;
+	}
+
+	epollEvents.resize(MaxEpollEvents);
+}
+
+StdScheduler::~StdScheduler()
+{
+	if (epollFD != -1) close(epollFD);
+}
+
+static std::uint32_t ToEpollEvents(const short events)
+{
+	return (events & POLLIN ? EPOLLIN : 0) | (events & POLLOUT ? EPOLLOUT : 0) | (events & POLLPRI ? EPOLLPRI : 0);
+}
+
+void StdScheduler::RegisterFDs(StdSchedulerProc *const proc)
+{
+	std::vector<pollfd> &registered{registeredFDs[proc]};
+
+	// A closed FD has left the epoll set silently, and its number may be back in the new set for another FD,
+	// so it is registered anew like an added FD.
+	{
+		CStdLock lock{&proc->closedFDsCSec};
+		closedFDs.swap(proc->closedFDs);
+	}
+	for (const int fd : closedFDs)
+	{
+		if (const auto it = std::ranges::lower_bound(registered, fd, {}, &pollfd::fd); it != registered.end() && it->fd == fd)
+		{
+			UnregisterFD(proc, fd);
+			registered.erase(it);
+		}
+	}
+	closedFDs.clear();
+
+	newFDs.clear();
+	proc->GetFDs(newFDs);
+	std::ranges::sort(newFDs, {}, &pollfd::fd);
+
+	// merge both sorted lists; unchanged FDs stay registered as they are
+	auto oldIt = registered.begin();
+	for (const pollfd &fd : newFDs)
+	{
+		// FDs which are no longer waited for
+		for (; oldIt != registered.end() && oldIt->fd < fd.fd; ++oldIt)
+		{
+			UnregisterFD(proc, oldIt->fd);
+		}
+
+		epoll_event event{.events = ToEpollEvents(fd.events), .data = {.ptr = proc}};
+		if (oldIt != registered.end() && oldIt->fd == fd.fd)
+		{
+			if (oldIt->events != fd.events)
+			{
+				epoll_ctl(epollFD, EPOLL_CTL_MOD, fd.fd, &event);
+			}
+			++oldIt;
+		}
+		else
+		{
+			// EEXIST: another proc has closed the FD with this number without telling yet
+			if (epoll_ctl(epollFD, EPOLL_CTL_ADD, fd.fd, &event) == -1 && errno == EEXIST)
+			{
+				epoll_ctl(epollFD, EPOLL_CTL_MOD, fd.fd, &event);
+			}
+			fdOwners[fd.fd] = proc;
+		}
+	}
+	for (; oldIt != registered.end(); ++oldIt)
+	{
+		UnregisterFD(proc, oldIt->fd);
+	}
+
+	registered.swap(newFDs);
+}
+
+void StdScheduler::UnregisterFD(StdSchedulerProc *const proc, const int fd)
+{
+	// the number may already belong to an FD of another proc
+	if (const auto it = fdOwners.find(fd); it != fdOwners.end() && it->second == proc)
+	{
+		// fails if the FD has already been closed
+		epoll_ctl(epollFD, EPOLL_CTL_DEL, fd, nullptr);
+		fdOwners.erase(it);
+	}
+}
+
+void StdScheduler::UnregisterFDs(StdSchedulerProc *const proc)
+{
+	const auto it = registeredFDs.find(proc);
+	if (it == registeredFDs.end()) return;
+
+	for (const pollfd &fd : it->second)
+	{
+		UnregisterFD(proc, fd.fd);
+	}
+	registeredFDs.erase(it);
+}
+
+bool StdScheduler::WaitEpoll(const int timeout)
+{
+	int cnt;
+	do
+	{
+		cnt = epoll_wait(epollFD, epollEvents.data(), static_cast<int>(epollEvents.size()), timeout < 0 ? -1 : timeout);
+	}
+	while (cnt == -1 && errno == EINTR);
+
+	if (cnt < 0)
+	{
+		printf("StdScheduler::Execute: epoll_wait failed %s\n", strerror(errno));
+		return true;
+	}
+
+	readyProcs.clear();
+	for (const epoll_event &event : std::span{epollEvents}.first(cnt))
+	{
+		auto *const proc = static_cast<StdSchedulerProc *>(event.data.ptr);
+		if (!proc)
+		{
+			unblocker.Reset();
+		}
+		else if (std::ranges::find(readyProcs, proc) == readyProcs.end())
+		{
+			readyProcs.emplace_back(proc);
+		}
+	}
+
+	bool success{true};
+	for (auto *const proc : readyProcs)
+	{
+		// may have been removed by a proc executed before
+		if (!procs.contains(proc)) continue;
+
+		if (!ExecuteProc(proc, 0))
+		{
+			success = false;
+		}
+	}
+
+	return success;
+}
+
+#endif
+
 void StdScheduler::Clear()
 {
 	procs.clear();
 #ifdef _WIN32
 	eventHandles.clear();
 	eventProcs.clear();
+#elif defined(__linux__)
+	while (!registeredFDs.empty())
+	{
+		UnregisterFDs(registeredFDs.begin()->first);
+	}
 #endif
 }
 
 void StdScheduler::Add(StdSchedulerProc *const proc)
 {
 	procs.insert(proc);
+#ifdef __linux__
+	if (epollFD != -1) RegisterFDs(proc);
+#endif
 }
 
 void StdScheduler::Remove(StdSchedulerProc *const proc)
 {
 	procs.erase(proc);
+#ifdef __linux__
+	if (epollFD != -1) UnregisterFDs(proc);
+#endif
+}
+
+bool StdScheduler::ExecuteProc(StdSchedulerProc *const proc, const int timeout)
+{
+	const bool success{proc->Execute(timeout)};
+	if (!success)
+	{
+		OnError(proc);
+	}
+
+#ifdef __linux__
+	// Execute() is where the FD set of the proc changes; OnError may have removed the proc
+	if (epollFD != -1 && procs.contains(proc)) RegisterFDs(proc);
+#endif
+
+	return success;
 }
 
 bool StdScheduler::Execute(int iTimeout)
@@ -119,6 +322,37 @@ bool StdScheduler::Execute(int iTimeout)
 	}
 
 #else
+	bool success;
+#ifdef __linux__
+	if (epollFD != -1)
+	{
+		success = WaitEpoll(iTimeout);
+	}
+	else
+#endif
+	{
+		success = WaitPoll(iTimeout);
+	}
+#endif
+
+	for (auto *const proc : procs)
+	{
+		if (proc->GetTimeout() == 0)
+		{
+			if (!ExecuteProc(proc, -1))
+			{
+				success = false;
+			}
+		}
+	}
+
+	return success;
+}
+
+#ifndef _WIN32
+
+bool StdScheduler::WaitPoll(const int timeout)
+{
 	fds.resize(1);
 
 	struct FdRange
@@ -143,7 +377,7 @@ bool StdScheduler::Execute(int iTimeout)
 	}
 
 	// Wait for something to happen
-	const int cnt{StdSync::Poll(fds, iTimeout)};
+	const int cnt{StdSync::Poll(fds, timeout)};
 
 	bool success{true};
 
@@ -161,9 +395,8 @@ bool StdScheduler::Execute(int iTimeout)
 		{
 			if (std::ranges::any_of(fdSpan.subspan(range.Offset, range.Size), std::identity{}, &pollfd::revents))
 			{
-				if (!proc->Execute(0))
+				if (!ExecuteProc(proc, 0))
 				{
-					OnError(proc);
 					success = false;
 				}
 			}
@@ -174,23 +407,11 @@ bool StdScheduler::Execute(int iTimeout)
 		printf("StdScheduler::Execute: poll failed %s\n", strerror(errno));
 	}
 
-#endif
-
-	for (auto *const proc : procs)
-	{
-		if (proc->GetTimeout() == 0)
-		{
-			if (!proc->Execute())
-			{
-				OnError(proc);
-				success = false;
-			}
-		}
-	}
-
 	return success;
 }
 
+#endif
+
 void StdScheduler::UnBlock()
 {
 	unblocker.Set();
@@ -26,6 +26,12 @@
 #include <vector>
 
 #include <poll.h>
+
+#ifdef __linux__
+#include <unordered_map>
+
+#include <sys/epoll.h>
+#endif
 #endif
 
 #include <thread>
@@ -51,20 +57,42 @@ public:
 #ifdef _WIN32
 	virtual HANDLE GetEvent() { return 0; }
 #else
+	// The set may only change during Execute(). Procs changing it from elsewhere have to make one of their own FDs
+	// readable afterwards (e.g. by writing to a pipe), so the scheduler executes them and picks up the new set.
 	virtual void GetFDs(std::vector<pollfd> &fds) {}
 #endif
 
 	// Call Execute() after this time has elapsed (no garantuees regarding accuracy)
 	// -1 means no timeout (infinity).
 	virtual int GetTimeout() { return -1; }
+
+#ifndef _WIN32
+protected:
+	// Has to be called after closing an FD of the set (mt-safe). The epoll scheduler only compares the set with
+	// the previous one, so it would miss a new FD that got the number of a closed one.
+	void OnFDClosed(int fd);
+
+#ifdef __linux__
+private:
+	CStdCSec closedFDsCSec;
+	std::vector<int> closedFDs; // not yet seen by the scheduler
+
+	friend class StdScheduler;
+#endif
+#endif
 };
 
 // A simple process scheduler
 class StdScheduler
 {
 public:
+#ifdef __linux__
+	StdScheduler();
+	virtual ~StdScheduler();
+#else
 	StdScheduler() = default;
 	virtual ~StdScheduler() = default;
+#endif
 
 private:
 	// Process list
@@ -80,6 +108,29 @@ private:
 #else
 	CStdEvent unblocker;
 	std::vector<pollfd> fds{{.fd = unblocker.GetFD(), .events = POLLIN}};
+
+#ifdef __linux__
+	// epoll backend: the FDs of each proc stay registered and are only re-read after the proc's Execute(),
+	// so a wakeup costs O(FDs of ready procs) instead of collecting and polling the FDs of all procs.
+	// Only FDs which have been added, changed, removed or closed since then cost an epoll_ctl call.
+	// If epoll is unavailable, epollFD is -1 and poll() is used.
+	static constexpr int MaxEpollEvents = 256;
+
+	int epollFD{-1};
+	std::unordered_map<StdSchedulerProc *, std::vector<pollfd>> registeredFDs; // sorted by fd
+	std::unordered_map<int, StdSchedulerProc *> fdOwners;
+	std::vector<pollfd> newFDs;
+	std::vector<int> closedFDs;
+	std::vector<epoll_event> epollEvents;
+	std::vector<StdSchedulerProc *> readyProcs;
+
+	void RegisterFDs(StdSchedulerProc *proc); // re-read FDs of the proc and update their registration
+	void UnregisterFD(StdSchedulerProc *proc, int fd);
+	void UnregisterFDs(StdSchedulerProc *proc);
+	bool WaitEpoll(int timeout);
+#endif
+
+	bool WaitPoll(int timeout);
 #endif
 
 public:
@@ -95,6 +146,9 @@ public:
 protected:
 	// overridable
 	virtual void OnError(StdSchedulerProc *pProc) {}
+
+private:
+	bool ExecuteProc(StdSchedulerProc *proc, int timeout);
 };
 
 // A simple process scheduler thread
@@ -0,0 +1,140 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include "StdAdaptors.h"
+#include "StdCompiler.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace
+{
+	template <class T>
+	StdBuf PackInt(T val)
+	{
+		return DecompileToBuf<StdCompilerBinWrite>(mkIntPackAdapt(val));
+	}
+
+	template <class T>
+	T UnpackInt(const StdBuf &buf)
+	{
+		T val{};
+		CompileFromBuf<StdCompilerBinRead>(mkIntPackAdapt(val), buf);
+		return val;
+	}
+
+	// same layout as C4PacketControlBatch: entry count, then client and tick relative to the previous entry
+	struct TestEntry
+	{
+		int32_t ClientID{}, CtrlTick{}, Data{};
+
+		bool operator==(const TestEntry &) const = default;
+	};
+
+	struct TestBatch
+	{
+		std::vector<TestEntry> Entries;
+
+		void CompileFunc(StdCompiler *pComp)
+		{
+			uint32_t iCount = static_cast<uint32_t>(Entries.size());
+			pComp->Value(mkNamingCountAdapt(iCount, "Ctrl"));
+			if (pComp->isCompiler())
+				Entries.resize(iCount);
+			int32_t iClientID = 0, iCtrlTick = 0;
+			for (auto &entry : Entries)
+			{
+				const auto name = pComp->Name("Ctrl");
+				pComp->Value(mkNamingAdapt(mkIntPackDeltaAdapt(entry.ClientID, iClientID), "ClientID", 0));
+				pComp->Value(mkNamingAdapt(mkIntPackDeltaAdapt(entry.CtrlTick, iCtrlTick), "CtrlTick", 0));
+				pComp->Value(mkNamingAdapt(mkIntPackAdapt(entry.Data),                     "Data",     0));
+			}
+		}
+	};
+}
+
+TEST_CASE("IntPack round trip", "[StdAdaptors]")
+{
+	for (const int32_t val : {0, 1, -1, 63, -64, 64, -65, 8191, -8192, 8192, 1 << 20, -(1 << 20),
+		std::numeric_limits<int32_t>::max(), std::numeric_limits<int32_t>::min()})
+	{
+		CHECK(UnpackInt<int32_t>(PackInt(val)) == val);
+	}
+
+	for (const uint32_t val : {0u, 127u, 128u, 16383u, 16384u, std::numeric_limits<uint32_t>::max()})
+	{
+		CHECK(UnpackInt<uint32_t>(PackInt(val)) == val);
+	}
+}
+
+TEST_CASE("IntPack size", "[StdAdaptors]")
+{
+	CHECK(PackInt<int32_t>(0).getSize() == 1);
+	CHECK(PackInt<int32_t>(63).getSize() == 1);
+	CHECK(PackInt<int32_t>(-64).getSize() == 1);
+	CHECK(PackInt<int32_t>(64).getSize() == 2);
+	CHECK(PackInt<int32_t>(-65).getSize() == 2);
+	CHECK(PackInt<uint32_t>(127u).getSize() == 1);
+	CHECK(PackInt<uint32_t>(128u).getSize() == 2);
+	CHECK(PackInt<int32_t>(std::numeric_limits<int32_t>::min()).getSize() == 5);
+}
+
+TEST_CASE("IntPackDelta round trip", "[StdAdaptors]")
+{
+	TestBatch batch;
+	batch.Entries = {
+		{3, 1000, 0},
+		{3, 1001, -5},
+		{3, 1002, 70000},
+		{1, 1002, 12},
+		{7, 999, -1},
+		{std::numeric_limits<int32_t>::max(), std::numeric_limits<int32_t>::min(), 1},
+		{std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max(), 2}
+	};
+
+	SECTION("binary")
+	{
+		const StdBuf buf{DecompileToBuf<StdCompilerBinWrite>(batch)};
+
+		TestBatch result;
+		CompileFromBuf<StdCompilerBinRead>(result, buf);
+		CHECK(result.Entries == batch.Entries);
+	}
+
+	SECTION("text")
+	{
+		const std::string text{DecompileToBuf<StdCompilerINIWrite>(mkNamingAdapt(batch, "Batch"))};
+
+		TestBatch result;
+		CompileFromBuf<StdCompilerINIRead>(mkNamingAdapt(result, "Batch"), StdStrBuf{text.c_str(), text.size(), false});
+		CHECK(result.Entries == batch.Entries);
+	}
+}
+
+TEST_CASE("IntPackDelta size", "[StdAdaptors]")
+{
+	// a run of one client's ticks takes one byte per header field
+	TestBatch batch;
+	for (int32_t i = 0; i < 100; ++i)
+		batch.Entries.push_back({42, 100000 + i, 0});
+
+	const StdBuf buf{DecompileToBuf<StdCompilerBinWrite>(batch)};
+	// count, first entry with large tick, then three bytes per entry
+	CHECK(buf.getSize() <= 1 + 5 + 99 * 3);
+}
@@ -0,0 +1,278 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include "StdScheduler.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace
+{
+	constexpr std::size_t PeerCount{64};
+	constexpr std::chrono::seconds Timeout{5};
+
+	// reads whatever arrives on its sockets and optionally echoes it; either one proc per socket or, like
+	// C4NetIOTCP, one proc owning the sockets of all peers
+	class LoopbackProc : public StdSchedulerProc
+	{
+	public:
+		LoopbackProc(const bool echo) : echo{echo} {}
+		~LoopbackProc() override
+		{
+			for (const pollfd &fd : fds)
+				close(fd.fd);
+		}
+
+		bool Execute(int = -1) override
+		{
+			// like C4NetIOTCP, look up which of its sockets are ready
+			if (poll(fds.data(), fds.size(), 0) < 0) return false;
+
+			for (const pollfd &fd : fds)
+			{
+				if (!(fd.revents & POLLIN)) continue;
+
+				char buf[256];
+				const auto size = recv(fd.fd, buf, sizeof(buf), 0);
+				if (size <= 0) return false;
+				received += static_cast<std::size_t>(size);
+				if (echo && send(fd.fd, buf, static_cast<std::size_t>(size), 0) != size) return false;
+			}
+			return true;
+		}
+
+		void GetFDs(std::vector<pollfd> &fds) override
+		{
+			for (const pollfd &fd : this->fds)
+				fds.push_back({.fd = fd.fd, .events = POLLIN});
+		}
+
+		void AddFD(const int fd) { fds.push_back({.fd = fd, .events = POLLIN}); }
+
+		// closes the FD and moves newFD to its number, as if a new connection had been accepted in its place
+		void ReplaceFD(const int fd, const int newFD)
+		{
+			close(fd);
+			OnFDClosed(fd);
+			REQUIRE(dup2(newFD, fd) == fd);
+			close(newFD);
+		}
+
+		std::size_t GetReceived() const { return received; }
+
+	private:
+		std::vector<pollfd> fds;
+		bool echo;
+		std::size_t received{0};
+	};
+
+	// a TCP connection over loopback; returns client and server end
+	std::pair<int, int> Connect(const int listener, const sockaddr_in &addr)
+	{
+		const int client{socket(AF_INET, SOCK_STREAM, 0)};
+		REQUIRE(client >= 0);
+		REQUIRE(connect(client, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr)) == 0);
+		const int server{accept(listener, nullptr, nullptr)};
+		REQUIRE(server >= 0);
+
+		for (const int fd : {client, server})
+		{
+			const int one{1};
+			setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+		}
+		return {client, server};
+	}
+
+	class Listener
+	{
+	public:
+		Listener()
+		{
+			fd = socket(AF_INET, SOCK_STREAM, 0);
+			REQUIRE(fd >= 0);
+
+			addr.sin_family = AF_INET;
+			addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+			socklen_t addrLen{sizeof(addr)};
+			REQUIRE(bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0);
+			REQUIRE(listen(fd, static_cast<int>(PeerCount)) == 0);
+			REQUIRE(getsockname(fd, reinterpret_cast<sockaddr *>(&addr), &addrLen) == 0);
+		}
+
+		~Listener() { close(fd); }
+
+		std::pair<int, int> Connect() { return ::Connect(fd, addr); }
+
+	private:
+		int fd;
+		sockaddr_in addr{};
+	};
+
+	// PeerCount loopback connections, both ends handled by the same scheduler: the server ends echo, the client ends count
+	class LoopbackPeers
+	{
+	public:
+		LoopbackPeers(const bool procPerSocket)
+		{
+			Listener listener;
+
+			for (std::size_t i{0}; i < PeerCount; ++i)
+			{
+				const auto [client, server] = listener.Connect();
+				clientFDs.push_back(client);
+
+				if (procPerSocket || procs.empty())
+				{
+					procs.push_back(std::make_unique<LoopbackProc>(false));
+					procs.push_back(std::make_unique<LoopbackProc>(true));
+				}
+				procs[procs.size() - 2]->AddFD(client);
+				procs[procs.size() - 1]->AddFD(server);
+			}
+
+			for (const auto &proc : procs)
+				scheduler.Add(proc.get());
+		}
+
+		~LoopbackPeers()
+		{
+			scheduler.Clear();
+		}
+
+		// the first count clients send one byte each and wait for the echoes; returns whether all echoes arrived
+		bool RoundTrip(const std::size_t count = PeerCount)
+		{
+			const std::size_t expected{received + count};
+			for (const int fd : std::span{clientFDs}.first(count))
+				if (send(fd, "x", 1, 0) != 1) return false;
+
+			const auto deadline = std::chrono::steady_clock::now() + Timeout;
+			while (received < expected)
+			{
+				if (!scheduler.Execute(100) || std::chrono::steady_clock::now() > deadline) return false;
+				received = 0;
+				for (std::size_t i{0}; i < procs.size(); i += 2)
+					received += procs[i]->GetReceived();
+			}
+			return received == expected;
+		}
+
+	private:
+		StdScheduler scheduler;
+		std::vector<std::unique_ptr<LoopbackProc>> procs; // client, server, client, server, ...
+		std::vector<int> clientFDs;
+		std::size_t received{0};
+	};
+
+	// lets the scheduler run until the proc has received the given number of bytes
+	bool WaitForReceived(StdScheduler &scheduler, const LoopbackProc &proc, const std::size_t expected)
+	{
+		const auto deadline = std::chrono::steady_clock::now() + Timeout;
+		while (proc.GetReceived() < expected)
+		{
+			if (!scheduler.Execute(100) || std::chrono::steady_clock::now() > deadline) return false;
+		}
+		return true;
+	}
+}
+
+TEST_CASE("Loopback round trips", "[StdScheduler]")
+{
+	SECTION("one proc per socket")
+	{
+		LoopbackPeers peers{true};
+		for (int i{0}; i < 100; ++i)
+			REQUIRE(peers.RoundTrip());
+	}
+
+	SECTION("one proc for all sockets")
+	{
+		LoopbackPeers peers{false};
+		for (int i{0}; i < 100; ++i)
+		{
+			REQUIRE(peers.RoundTrip());
+			REQUIRE(peers.RoundTrip(1));
+		}
+	}
+}
+
+TEST_CASE("Reused FD numbers", "[StdScheduler]")
+{
+	Listener listener;
+	const auto [controlClient, controlServer] = listener.Connect();
+	const auto [oldClient, oldServer] = listener.Connect();
+
+	LoopbackProc proc{false};
+	proc.AddFD(controlServer);
+	proc.AddFD(oldServer);
+
+	StdScheduler scheduler;
+	scheduler.Add(&proc);
+
+	// the set looks unchanged afterwards, but the number now belongs to another connection
+	const auto [newClient, newServer] = listener.Connect();
+	proc.ReplaceFD(oldServer, newServer);
+	close(oldClient);
+
+	// the proc has to run once for the scheduler to take note
+	REQUIRE(send(controlClient, "x", 1, 0) == 1);
+	REQUIRE(WaitForReceived(scheduler, proc, 1));
+
+	REQUIRE(send(newClient, "x", 1, 0) == 1);
+	CHECK(WaitForReceived(scheduler, proc, 2));
+
+	scheduler.Clear();
+	close(controlClient);
+	close(newClient);
+}
+
+TEST_CASE("Loopback round trip benchmark", "[StdScheduler][!benchmark]")
+{
+	LoopbackPeers procPerSocket{true};
+	LoopbackPeers procForAll{false};
+
+	BENCHMARK("Round trip of 64 peers, one proc per socket")
+	{
+		return procPerSocket.RoundTrip();
+	};
+
+	BENCHMARK("Round trip of 64 peers, one proc for all sockets")
+	{
+		return procForAll.RoundTrip();
+	};
+
+	BENCHMARK("Round trip of 1 of 64 peers, one proc for all sockets")
+	{
+		return procForAll.RoundTrip(1);
+	};
+}
+
+#endif